@@ -63,3 +63,11 @@ void Ram_session_component::_clear_ds (Dataspace_component *ds)
 	/* free core's virtual address space */
 	platform()->region_alloc()->free(virt_addr, page_rounded_size);
 }
+
+
+/*
+ * RAM dataspaces are not mapped within core, so clients have to copy
+ * dataspaces themselves.
+ */
+bool Ram_session_component::_copy_ds(Dataspace_component *, Dataspace_component *) {
+	return false; }
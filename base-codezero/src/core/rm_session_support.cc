@@ -26,3 +26,6 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 {
 	l4_unmap((void *)virt_base, size >> get_page_size_log2(), badge());
 }
+
+
+void Rm_client::map(addr_t, addr_t, size_t, bool) { }
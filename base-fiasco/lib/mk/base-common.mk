@@ -12,7 +12,9 @@ SRC_CC += pager/pager.cc
 SRC_CC += avl_tree/avl_tree.cc
 SRC_CC += allocator/slab.cc
 SRC_CC += allocator/allocator_avl.cc
-SRC_CC += heap/heap.cc heap/sliced_heap.cc
+SRC_CC += allocator/allocator_stats.cc
+SRC_CC += trace/trace.cc
+SRC_CC += heap/heap.cc heap/sliced_heap.cc heap/thread_cached_heap.cc
 SRC_CC += console/console.cc
 SRC_CC += child/child.cc
 SRC_CC += process/process.cc
@@ -22,7 +24,7 @@ SRC_CC += signal/signal.cc signal/common.cc
 SRC_CC += server/server.cc server/common.cc
 SRC_CC += thread/thread.cc thread/thread_bootstrap_empty.cc
 
-INC_DIR += $(REP_DIR)/src/base/lock
+INC_DIR += $(REP_DIR)/src/base/lock $(BASE_DIR)/src/base/lock
 
 vpath cap_copy.cc $(BASE_DIR)/src/platform
 vpath %.cc         $(REP_DIR)/src/base
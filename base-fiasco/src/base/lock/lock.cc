@@ -16,6 +16,9 @@
 #include <cpu/atomic.h>
 #include <base/printf.h>
 
+/* local includes */
+#include <lock_trace.h>
+
 /* L4/Fiasco includes */
 namespace Fiasco {
 #include <l4/sys/ipc.h>
@@ -38,9 +41,16 @@ void Cancelable_lock::lock()
 	 * XXX: How to notice cancel-blocking signals issued when  being outside the
 	 *      'l4_ipc_sleep' system call?
 	 */
+	if (Genode::cmpxchg(&_lock, UNLOCKED, LOCKED))
+		return;
+
+	Trace::Timestamp const blocked = lock_contention_start();
+
 	while (!Genode::cmpxchg(&_lock, UNLOCKED, LOCKED))
 		if (Fiasco::l4_ipc_sleep(Fiasco::l4_ipc_timeout(0, 0, 500, 0)) != L4_IPC_RETIMEOUT)
 			throw Genode::Blocking_canceled();
+
+	lock_contention_end(this, blocked);
 }
 
 
@@ -18,6 +18,7 @@
 
 /* Genode includes */
 #include <base/rpc_server.h>
+#include <trace/events.h>
 
 using namespace Genode;
 
@@ -32,7 +33,7 @@ Untyped_capability Rpc_entrypoint::_manage(Rpc_object_base *obj)
 
 	/* add server object to object pool */
 	obj->cap(new_obj_cap);
-	insert(obj);
+	_pool.insert(obj);
 
 	/* return capability that uses the object id as badge */
 	return new_obj_cap;
@@ -71,7 +72,7 @@ void Rpc_entrypoint::entry()
 		}
 
 		/* atomically lookup and lock referenced object */
-		Object_pool<Rpc_object_base>::Guard curr_obj(lookup_and_lock(srv.badge()));
+		Object_pool<Rpc_object_base>::Guard curr_obj(_pool.lookup_and_lock(srv.badge()));
 		if (!curr_obj)
 			continue;
 
@@ -81,8 +82,10 @@ void Rpc_entrypoint::entry()
 		}
 
 		/* dispatch request */
+		Trace::event(Trace::RPC_DISPATCH, opcode, srv.badge());
 		try { srv.ret(_curr_obj->dispatch(opcode, srv, srv)); }
 		catch (Blocking_canceled) { }
+		Trace::event(Trace::RPC_REPLY, opcode, srv.badge());
 
 		{
 			Lock::Guard lock_guard(_curr_obj_lock);
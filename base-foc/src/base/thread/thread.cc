@@ -13,6 +13,7 @@
 
 #include <base/thread.h>
 #include <base/env.h>
+#include <base/heap.h>
 #include <base/snprintf.h>
 #include <util/string.h>
 #include <util/misc_math.h>
@@ -59,6 +60,10 @@ bool Thread_base::Context_allocator::_is_in_use(addr_t base)
 		if (base_to_context(base) == le->object()->_context)
 			return true;
 
+	for (unsigned i = 0; i < _num_recycled; i++)
+		if (base_to_context(base) == _recycled[i])
+			return true;
+
 	return false;
 }
 
@@ -84,6 +89,27 @@ Thread_base::Context *Thread_base::Context_allocator::alloc(Thread_base *thread_
 }
 
 
+Thread_base::Context *
+Thread_base::Context_allocator::alloc_recycled(Thread_base *thread_base,
+                                               size_t ds_size)
+{
+	Lock::Guard _lock_guard(_threads_lock);
+
+	for (unsigned i = 0; i < _num_recycled; i++) {
+
+		Context *context = _recycled[i];
+		if (context->ds_size != ds_size)
+			continue;
+
+		_recycled[i] = _recycled[--_num_recycled];
+		_recycled_size -= ds_size;
+		_threads.insert(&thread_base->_list_element);
+		return context;
+	}
+	return 0;
+}
+
+
 void Thread_base::Context_allocator::free(Thread_base *thread_base)
 {
 	Lock::Guard _lock_guard(_threads_lock);
@@ -94,6 +120,23 @@ void Thread_base::Context_allocator::free(Thread_base *thread_base)
 }
 
 
+bool Thread_base::Context_allocator::recycle(Thread_base *thread_base)
+{
+	Lock::Guard _lock_guard(_threads_lock);
+
+	Context * const context = thread_base->_context;
+
+	if (_num_recycled == MAX_RECYCLED
+	 || _recycled_size + context->ds_size > MAX_RECYCLED_SIZE)
+		return false;
+
+	_recycled[_num_recycled++] = context;
+	_recycled_size += context->ds_size;
+	_threads.remove(&thread_base->_list_element);
+	return true;
+}
+
+
 /*****************
  ** Thread base **
  *****************/
@@ -115,11 +158,6 @@ Thread_base::Context *Thread_base::_alloc_context(size_t stack_size)
 	static Lock alloc_lock;
 	Lock::Guard _lock_guard(alloc_lock);
 
-	/* allocate thread context */
-	Context *context = _context_allocator()->alloc(this);
-	if (!context)
-		throw Context_alloc_failed();
-
 	/* determine size of dataspace to allocate for context members and stack */
 	enum { PAGE_SIZE_LOG2 = 12 };
 	size_t ds_size = align_addr(stack_size, PAGE_SIZE_LOG2);
@@ -127,6 +165,18 @@ Thread_base::Context *Thread_base::_alloc_context(size_t stack_size)
 	if (stack_size >= Native_config::context_virtual_size() - sizeof(Native_utcb) - (1 << PAGE_SIZE_LOG2))
 		throw Stack_too_large();
 
+	/* reuse context of a destroyed thread, including its backing store */
+	Context *context = _context_allocator()->alloc_recycled(this, ds_size);
+	if (context) {
+		context->thread_base = this;
+		return context;
+	}
+
+	/* allocate thread context */
+	context = _context_allocator()->alloc(this);
+	if (!context)
+		throw Context_alloc_failed();
+
 	/*
 	 * Calculate base address of the stack
 	 *
@@ -162,12 +212,17 @@ Thread_base::Context *Thread_base::_alloc_context(size_t stack_size)
 	context->thread_base = this;
 	context->stack_base  = ds_addr;
 	context->ds_cap      = ds_cap;
+	context->ds_size     = ds_size;
 	return context;
 }
 
 
 void Thread_base::_free_context()
 {
+	/* keep context for the next thread to be created */
+	if (_context_allocator()->recycle(this))
+		return;
+
 	addr_t ds_addr = _context->stack_base - Native_config::context_area_virtual_base();
 	Ram_dataspace_capability ds_cap = _context->ds_cap;
 	_context_allocator()->free(this);
@@ -199,7 +254,8 @@ Thread_base::Thread_base(const char *name, size_t stack_size)
 :
 	_list_element(this),
 	_context(_alloc_context(stack_size)),
-	_join_lock(Lock::LOCKED)
+	_join_lock(Lock::LOCKED),
+	_trace_logger(name)
 {
 	strncpy(_context->name, name, sizeof(_context->name));
 	_init_platform_thread();
@@ -209,5 +265,9 @@ Thread_base::Thread_base(const char *name, size_t stack_size)
 Thread_base::~Thread_base()
 {
 	_deinit_platform_thread();
+
+	/* return memory cached for the thread by thread-cached heaps */
+	Thread_cached_heap::release_thread_caches(this);
+
 	_free_context();
 }
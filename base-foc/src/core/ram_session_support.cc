@@ -33,3 +33,14 @@ void Ram_session_component::_clear_ds(Dataspace_component *ds)
 			Fiasco::l4_cache_dma_coherent(ds->phys_addr(), ds->phys_addr() + ds->size());
 }
 
+
+bool Ram_session_component::_copy_ds(Dataspace_component *src,
+                                     Dataspace_component *dst)
+{
+	memcpy((void *)dst->phys_addr(), (void *)src->phys_addr(), src->size());
+
+	if (dst->write_combined())
+		Fiasco::l4_cache_dma_coherent(dst->phys_addr(), dst->phys_addr() + dst->size());
+
+	return true;
+}
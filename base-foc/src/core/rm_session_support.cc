@@ -13,6 +13,7 @@
 
 /* core includes */
 #include <rm_session_component.h>
+#include <platform_pd.h>
 #include <map_local.h>
 
 using namespace Genode;
@@ -22,3 +23,43 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 	// TODO unmap it only from target space
 	unmap_local(core_local_base, size >> get_page_size_log2());
 }
+
+
+void Rm_client::map(addr_t core_local_base, addr_t virt_base, size_t size,
+                    bool writeable)
+{
+	using namespace Fiasco;
+
+	Locked_ptr<Address_space> locked_address_space(_address_space);
+	if (!locked_address_space.is_valid())
+		return;
+
+	/* on Fiasco.OC, the address space of a client is a 'Platform_pd' */
+	Platform_pd * const pd =
+		static_cast<Platform_pd *>(locked_address_space.operator->());
+
+	unsigned char const rights = writeable ? L4_FPAGE_RW : L4_FPAGE_RO;
+
+	addr_t const end = virt_base + size;
+	while (virt_base < end) {
+
+		/* use the largest flexpage aligned at both the source and destination */
+		size_t size_log2 = get_page_size_log2();
+		while (size_log2 < get_super_page_size_log2()
+		    && !((core_local_base | virt_base) & ((2UL << size_log2) - 1))
+		    && virt_base + (2UL << size_log2) <= end)
+			size_log2++;
+
+		l4_fpage_t const snd_fpage = l4_fpage(core_local_base, size_log2, rights);
+
+		if (l4_msgtag_has_error(l4_task_map(pd->native_task().dst(),
+		                                    L4_BASE_TASK_CAP, snd_fpage,
+		                                    virt_base))) {
+			PWRN("could not map 0x%lx to 0x%lx", core_local_base, virt_base);
+			return;
+		}
+
+		core_local_base += 1UL << size_log2;
+		virt_base       += 1UL << size_log2;
+	}
+}
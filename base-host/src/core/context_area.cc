@@ -30,7 +30,7 @@ class Context_area_rm_session : public Genode::Rm_session
 		 */
 		Local_addr attach(Genode::Dataspace_capability ds_cap,
 		                  Genode::size_t size, Genode::off_t offset,
-		                  bool use_local_addr, Local_addr local_addr, bool)
+		                  bool use_local_addr, Local_addr local_addr, bool, bool)
 		{
 			PWRN("not implemented");
 			return local_addr;
@@ -62,6 +62,9 @@ class Context_area_ram_session : public Genode::Ram_session
 
 		void free(Genode::Ram_dataspace_capability) { }
 
+		Genode::Ram_dataspace_capability clone(Genode::Ram_dataspace_capability) {
+			return Genode::Ram_dataspace_capability(); }
+
 		int ref_account(Genode::Ram_session_capability) { return 0; }
 
 		int transfer_quota(Genode::Ram_session_capability, Genode::size_t) { return 0; }
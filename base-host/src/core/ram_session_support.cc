@@ -27,3 +27,10 @@ void Ram_session_component::_clear_ds (Dataspace_component *ds)
 {
 	PWRN("not implemented");
 }
+
+
+bool Ram_session_component::_copy_ds(Dataspace_component *, Dataspace_component *)
+{
+	PWRN("not implemented");
+	return false;
+}
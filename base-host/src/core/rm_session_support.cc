@@ -24,3 +24,6 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 {
 	PWRN("not implemented");
 }
+
+
+void Rm_client::map(addr_t, addr_t, size_t, bool) { }
@@ -15,6 +15,7 @@
 #include <base/thread.h>
 #include <base/signal.h>
 #include <signal_session/connection.h>
+#include <trace/events.h>
 #include <kernel/syscalls.h>
 
 using namespace Genode;
@@ -76,6 +77,7 @@ Signal::Signal(Signal::Data data) : _data(data)
 void Signal_transmitter::submit(unsigned cnt)
 {
 	/* submits to invalid signal contexts get ignored */
+	Trace::event(Trace::SIGNAL_SUBMIT, _context.dst(), cnt);
 	Kernel::submit_signal(_context.dst(), cnt);
 }
 
@@ -200,6 +202,7 @@ Signal Signal_receiver::wait_for_signal()
 	}
 	/* check attributes of the signal and return it */
 	if (s.num() == 0) PWRN("Returning signal with num == 0");
+	Trace::event(Trace::SIGNAL_RECEIVED, (addr_t)c, s.num());
 	return s;
 }
 
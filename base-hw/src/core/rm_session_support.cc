@@ -48,6 +48,9 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 }
 
 
+void Rm_client::map(addr_t, addr_t, size_t, bool) { }
+
+
 /***************
  ** Ipc_pager **
  ***************/
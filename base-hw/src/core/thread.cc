@@ -60,7 +60,7 @@ void Thread_base::_thread_start()
 
 
 Thread_base::Thread_base(const char *name, size_t stack_size)
-: _list_element(this)
+: _list_element(this), _trace_logger(name)
 {
 	_tid.pt = new (platform()->core_mem_alloc())
 		Platform_thread(name, this, stack_size, Kernel::core_id());
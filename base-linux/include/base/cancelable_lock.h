@@ -0,0 +1,69 @@
+/*
+ * \brief  Basic locking primitive
+ * \author Norman Feske
+ * \author agent
+ * \date   2006-07-26
+ *
+ * On Linux, the lock is a futex word. A contending thread spins for a short
+ * while and then blocks in the kernel until the lock holder wakes it up.
+ */
+
+/*
+ * Copyright (C) 2006-2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__CANCELABLE_LOCK_H_
+#define _INCLUDE__BASE__CANCELABLE_LOCK_H_
+
+#include <base/lock_guard.h>
+#include <base/blocking.h>
+
+namespace Genode {
+
+	class Cancelable_lock
+	{
+		private:
+
+			/*
+			 * States of the futex word
+			 *
+			 * The 'CONTENDED' state tells the lock holder that there may
+			 * be threads blocking in the kernel, which must be woken up
+			 * on 'unlock'.
+			 */
+			enum { FREE = 0, TAKEN = 1, CONTENDED = 2 };
+
+			int volatile _futex;
+
+		public:
+
+			enum State { LOCKED, UNLOCKED };
+
+			/**
+			 * Constructor
+			 */
+			explicit Cancelable_lock(State initial = UNLOCKED);
+
+			/**
+			 * Try to aquire lock an block while lock is not free
+			 *
+			 * This function may throw a Genode::Blocking_canceled exception.
+			 */
+			void lock();
+
+			/**
+			 * Release lock
+			 */
+			void unlock();
+
+			/**
+			 * Lock guard
+			 */
+			typedef Genode::Lock_guard<Cancelable_lock> Guard;
+	};
+}
+
+#endif /* _INCLUDE__BASE__CANCELABLE_LOCK_H_ */
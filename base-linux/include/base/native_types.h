@@ -45,6 +45,64 @@ namespace Genode {
 	};
 
 	struct Thread_meta_data;
+	struct Shm_slot;
+	class  Shm_server;
+
+	/**
+	 * Client-side state of a shared-memory RPC connection
+	 *
+	 * A connection refers to a slot of the entrypoint addressed by
+	 * 'dst_sd'. A connection without slot marks an entrypoint
+	 * that refused to establish a shared-memory connection.
+	 *
+	 * Because socket descriptors get reused after being closed, the
+	 * connection records the identity of the socket as well. A connection
+	 * is valid only as long as 'dst_sd' refers to the same socket.
+	 */
+	struct Native_shm_connection
+	{
+		int                 dst_sd;
+		unsigned long long  dst_dev;
+		unsigned long long  dst_ino;
+		Shm_slot           *slot;
+
+		/**
+		 * Default constructor creates unused connection
+		 */
+		Native_shm_connection()
+		: dst_sd(-1), dst_dev(0), dst_ino(0), slot(0) { }
+
+		bool used() const { return dst_sd != -1; }
+	};
+
+	/**
+	 * Socket pair used by a thread for receiving RPC replies
+	 *
+	 * The reply channel is created by the IPC library on the first RPC call
+	 * of the thread and reused for all subsequent calls. The remote socket
+	 * is handed out to the server along with each request. The local socket
+	 * is the one the thread blocks on while waiting for the reply.
+	 *
+	 * Shared-memory connections are bound to the reply channel because the
+	 * server uses the remote socket for replies that cannot be transferred
+	 * via shared memory.
+	 */
+	struct Native_reply_channel
+	{
+		enum { MAX_SHM_CONNECTIONS = 4 };
+
+		int local_sd;
+		int remote_sd;
+
+		Native_shm_connection shm_connections[MAX_SHM_CONNECTIONS];
+
+		/**
+		 * Default constructor creates not-yet-initialized reply channel
+		 */
+		Native_reply_channel() : local_sd(-1), remote_sd(-1) { }
+
+		bool valid() const { return local_sd != -1; }
+	};
 
 	/**
 	 * Native thread contains more thread-local data than just the ID
@@ -61,11 +119,6 @@ namespace Genode {
 	{
 		bool is_ipc_server;
 
-		/**
-		 * Natively aligned memory location used in the lock implementation
-		 */
-		int futex_counter __attribute__((aligned(sizeof(Genode::addr_t))));
-
 		/**
 		 * Opaque pointer to additional thread-specific meta data
 		 *
@@ -75,7 +128,21 @@ namespace Genode {
 		 */
 		Thread_meta_data *meta_data;
 
-		Native_thread() : is_ipc_server(false), futex_counter(0), meta_data(0) { }
+		/**
+		 * Reply channel used for the RPC calls issued by the thread
+		 */
+		Native_reply_channel reply_channel;
+
+		/**
+		 * Server-side state of the shared-memory RPC transport
+		 *
+		 * This pointer is used by entrypoints only. It is initialized when
+		 * the first client establishes a shared-memory connection.
+		 */
+		Shm_server *shm_server;
+
+		Native_thread()
+		: is_ipc_server(false), meta_data(0), shm_server(0) { }
 	};
 
 	inline bool operator == (Native_thread_id t1, Native_thread_id t2) {
@@ -40,8 +40,9 @@ namespace Genode {
 		 ** Linux-specific dataspace interface **
 		 ****************************************/
 
-		Filename           fname() { return call<Rpc_fname>(); }
-		Untyped_capability fd()    { return call<Rpc_fd>(); }
+		Filename           fname()      { return call<Rpc_fname>(); }
+		Untyped_capability fd()         { return call<Rpc_fd>(); }
+		bool               huge_pages() { return call<Rpc_huge_pages>(); }
 	};
 }
 
@@ -41,6 +41,11 @@ namespace Genode {
 		 */
 		virtual Untyped_capability fd() = 0;
 
+		/**
+		 * Return true if the dataspace should be mapped using huge pages
+		 */
+		virtual bool huge_pages() = 0;
+
 		/*********************
 		 ** RPC declaration **
 		 *********************/
@@ -48,7 +53,8 @@ namespace Genode {
 
 		GENODE_RPC(Rpc_fname, Filename, fname);
 		GENODE_RPC(Rpc_fd, Untyped_capability, fd);
-		GENODE_RPC_INTERFACE_INHERIT(Dataspace, Rpc_fname, Rpc_fd);
+		GENODE_RPC(Rpc_huge_pages, bool, huge_pages);
+		GENODE_RPC_INTERFACE_INHERIT(Dataspace, Rpc_fname, Rpc_fd, Rpc_huge_pages);
 	};
 }
 
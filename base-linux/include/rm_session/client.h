@@ -34,10 +34,11 @@ namespace Genode {
 
 		Local_addr attach(Dataspace_capability ds, size_t size, off_t offset,
 		                  bool use_local_addr, Local_addr local_addr,
-		                  bool executable = false)
+		                  bool executable = false,
+		                  bool populate = false)
 		{
 			return _local()->attach(ds, size, offset, use_local_addr,
-			                        local_addr, executable);
+			                        local_addr, executable, populate);
 		}
 
 		void detach(Local_addr local_addr) {
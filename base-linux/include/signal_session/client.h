@@ -0,0 +1,69 @@
+/*
+ * \brief  Linux-specific client-side signal session interface
+ * \author agent
+ * \date   2026-10-17
+ *
+ * On Linux, signals are not submitted via core. Instead, a signal-context
+ * capability refers directly to the datagram socket of the signal-handler
+ * thread of the receiving process and carries the imprint of the context as
+ * its local name. A signal is submitted by sending a datagram to this
+ * socket. Core is merely involved in the allocation and release of signal
+ * contexts.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__SIGNAL_SESSION__CLIENT_H_
+#define _INCLUDE__SIGNAL_SESSION__CLIENT_H_
+
+#include <util/list.h>
+#include <base/lock.h>
+#include <signal_session/capability.h>
+#include <signal_session/signal_session.h>
+#include <base/rpc_client.h>
+#include <signal_session/source_client.h>
+
+namespace Genode {
+
+	class Signal_session_client : public Rpc_client<Signal_session>
+	{
+		private:
+
+			/**
+			 * Association of a directly addressed signal context with the
+			 * capability of the corresponding context within core
+			 */
+			struct Context : List<Context>::Element
+			{
+				long                      const imprint;
+				Signal_context_capability const core_cap;
+
+				Context(long imprint, Signal_context_capability core_cap)
+				: imprint(imprint), core_cap(core_cap) { }
+			};
+
+			Lock          _contexts_lock;
+			List<Context> _contexts;
+
+		public:
+
+			explicit Signal_session_client(Signal_session_capability session)
+			: Rpc_client<Signal_session>(session) { }
+
+			Signal_source_capability signal_source() {
+				return call<Rpc_signal_source>(); }
+
+			Signal_context_capability alloc_context(long imprint);
+
+			void free_context(Signal_context_capability cap);
+
+			void submit(Signal_context_capability receiver, unsigned cnt = 1);
+	};
+}
+
+#endif /* _INCLUDE__SIGNAL_SESSION__CLIENT_H_ */
@@ -0,0 +1,52 @@
+/*
+ * \brief  Linux-specific signal-source client interface
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The signal source does not block at core but at the datagram socket that
+ * is addressed by the signal-context capabilities of the process (see
+ * 'signal_session/client.h').
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__SIGNAL_SESSION__SOURCE_CLIENT_H_
+#define _INCLUDE__SIGNAL_SESSION__SOURCE_CLIENT_H_
+
+#include <signal_session/source.h>
+#include <base/rpc_client.h>
+
+namespace Genode {
+
+	class Signal_source_client : public Rpc_client<Signal_source>
+	{
+		private:
+
+			int _server_sd;  /* socket for receiving signals */
+
+		public:
+
+			/**
+			 * Constructor
+			 *
+			 * The constructor must be called by the thread that is going to
+			 * call 'wait_for_signal' because the socket is bound to the
+			 * calling thread.
+			 */
+			Signal_source_client(Signal_source_capability signal_source);
+
+
+			/*****************************
+			 ** Signal source interface **
+			 *****************************/
+
+			Signal wait_for_signal();
+	};
+}
+
+#endif /* _INCLUDE__SIGNAL_SESSION__SOURCE_CLIENT_H_ */
@@ -10,16 +10,27 @@ SRC_CC += ipc/ipc.cc
 SRC_CC += avl_tree/avl_tree.cc
 SRC_CC += allocator/slab.cc
 SRC_CC += allocator/allocator_avl.cc
-SRC_CC += heap/heap.cc heap/sliced_heap.cc
+SRC_CC += allocator/allocator_stats.cc
+SRC_CC += trace/trace.cc
+SRC_CC += heap/heap.cc heap/sliced_heap.cc heap/thread_cached_heap.cc
 SRC_CC += console/console.cc
 SRC_CC += child/child.cc
 SRC_CC += process/process.cc
 SRC_CC += elf/elf_binary.cc
 SRC_CC += lock/lock.cc
 SRC_CC += env/rm_session_mmap.cc env/debug.cc
-SRC_CC += signal/signal.cc signal/common.cc
+SRC_CC += signal/signal.cc signal/common.cc signal/signal_linux.cc
 SRC_CC += server/server.cc server/common.cc
 
+#
+# The shared-memory RPC transport is enabled by adding 'lx_shm_ipc' to SPECS
+#
+ifeq ($(filter-out $(SPECS),lx_shm_ipc),)
+SRC_CC += ipc/shm_transport_on.cc
+else
+SRC_CC += ipc/shm_transport_off.cc
+endif
+
 INC_DIR += $(REP_DIR)/src/base/lock $(BASE_DIR)/src/base/lock
 INC_DIR += $(REP_DIR)/src/base/ipc
 INC_DIR += $(REP_DIR)/src/base/env
@@ -50,6 +50,13 @@ Platform_env_base::Rm_session_mmap::_dataspace_writable(Dataspace_capability ds)
 }
 
 
+bool
+Platform_env_base::Rm_session_mmap::_dataspace_huge_pages(Dataspace_capability ds)
+{
+	return Linux_dataspace_client(ds).huge_pages();
+}
+
+
 /********************************
  ** Platform_env::Local_parent **
  ********************************/
@@ -204,7 +204,8 @@ namespace Genode {
 					                 addr_t               offset,
 					                 bool                 use_local_addr,
 					                 addr_t               local_addr,
-					                 bool                 executable);
+					                 bool                 executable,
+					                 bool                 populate = false);
 
 					/**
 					 * Determine size of dataspace
@@ -226,6 +227,12 @@ namespace Genode {
 					 */
 					bool _dataspace_writable(Capability<Dataspace>);
 
+					/**
+					 * Determine whether dataspace should be mapped using
+					 * huge pages
+					 */
+					bool _dataspace_huge_pages(Capability<Dataspace>);
+
 				public:
 
 					Rm_session_mmap(bool sub_rm, size_t size = ~0)
@@ -245,7 +252,8 @@ namespace Genode {
 
 					Local_addr attach(Dataspace_capability ds, size_t size,
 					                  off_t, bool, Local_addr,
-					                  bool executable);
+					                  bool executable,
+					                  bool populate);
 
 					void detach(Local_addr local_addr);
 
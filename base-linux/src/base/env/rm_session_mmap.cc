@@ -31,18 +31,68 @@ static bool is_sub_rm_session(Dataspace_capability ds)
 }
 
 
+enum { HUGE_PAGE_SIZE = 2*1024*1024 };
+
+
+/**
+ * Reserve virtual address range aligned to a huge page
+ *
+ * \return base of reserved range, or 0 if the reservation failed
+ */
+static addr_t reserve_huge_page_aligned(Genode::size_t size)
+{
+	Genode::size_t const reserve_size = size + HUGE_PAGE_SIZE;
+
+	addr_t const reserved = lx_vm_reserve(0, reserve_size);
+	if (((long)reserved < 0) && ((long)reserved > -4095))
+		return 0;
+
+	addr_t const aligned = align_addr(reserved, 21);
+
+	/* release the parts of the reservation outside the aligned range */
+	if (aligned > reserved)
+		lx_munmap((void *)reserved, aligned - reserved);
+
+	addr_t const end = aligned + size;
+	if (reserved + reserve_size > end)
+		lx_munmap((void *)end, reserved + reserve_size - end);
+
+	return aligned;
+}
+
+
 void *
 Platform_env_base::Rm_session_mmap::_map_local(Dataspace_capability ds,
                                                Genode::size_t       size,
                                                addr_t               offset,
                                                bool                 use_local_addr,
                                                addr_t               local_addr,
-                                               bool                 executable)
+                                               bool                 executable,
+                                               bool                 populate)
 {
 	int  const  fd        = _dataspace_fd(ds);
 	bool const  writable  = _dataspace_writable(ds);
+	bool const  huge      = size >= HUGE_PAGE_SIZE && _dataspace_huge_pages(ds);
 
-	int  const  flags     = MAP_SHARED | (use_local_addr ? MAP_FIXED : 0);
+	/*
+	 * Huge pages can only be used for naturally aligned virtual addresses.
+	 * If no local address is requested, we pick a suitably aligned one. If
+	 * no such address range is available, the dataspace is mapped with
+	 * normal pages.
+	 */
+	bool reserved = false;
+	if (huge && !use_local_addr) {
+		local_addr     = reserve_huge_page_aligned(size);
+		use_local_addr = reserved = local_addr != 0;
+	}
+
+	/*
+	 * Huge-page mappings are populated after applying the huge-page advice
+	 * because 'MAP_POPULATE' would fault in normal pages.
+	 */
+	int  const  flags     = MAP_SHARED
+	                      | (use_local_addr    ? MAP_FIXED    : 0)
+	                      | (populate && !huge ? MAP_POPULATE : 0);
 	int  const  prot      = PROT_READ
 	                      | (writable   ? PROT_WRITE : 0)
 	                      | (executable ? PROT_EXEC  : 0);
@@ -59,9 +109,25 @@ Platform_env_base::Rm_session_mmap::_map_local(Dataspace_capability ds,
 
 	if (((long)addr_out < 0) && ((long)addr_out > -4095)) {
 		PERR("_map_local: return value of mmap is %ld", (long)addr_out);
+
+		if (reserved)
+			lx_munmap((void *)local_addr, size);
+
 		throw Rm_session::Region_conflict();
 	}
 
+	/*
+	 * The advice is ignored by kernels without support for transparent huge
+	 * pages for shared memory, in which case normal pages are used.
+	 */
+	if (huge)
+		lx_madvise(addr_out, size, LX_MADV_HUGEPAGE);
+
+	/* kernels without support for the populate advice fault in lazily */
+	if (huge && populate)
+		lx_madvise(addr_out, size, writable ? LX_MADV_POPULATE_WRITE
+		                                    : LX_MADV_POPULATE_READ);
+
 	return addr_out;
 }
 
@@ -80,7 +146,8 @@ Platform_env::Rm_session_mmap::attach(Dataspace_capability ds,
                                       size_t size, off_t offset,
                                       bool use_local_addr,
                                       Rm_session::Local_addr local_addr,
-                                      bool executable)
+                                      bool executable,
+                                      bool populate)
 {
 	Lock::Guard lock_guard(_lock);
 
@@ -146,7 +213,8 @@ Platform_env::Rm_session_mmap::attach(Dataspace_capability ds,
 		 * and map it.
 		 */
 		if (_is_attached())
-			_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr, executable);
+			_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr,
+			           executable, populate);
 
 		return (void *)local_addr;
 
@@ -207,7 +275,7 @@ Platform_env::Rm_session_mmap::attach(Dataspace_capability ds,
 			 * Boring, a plain dataspace is attached to a root RM session.
 			 */
 			void *addr = _map_local(ds, region_size, offset, use_local_addr,
-			                        local_addr, executable);
+			                        local_addr, executable, populate);
 
 			_add_to_rmap(Region((addr_t)addr, offset, ds, region_size));
 
@@ -36,6 +36,7 @@
 
 /* local includes */
 #include <socket_descriptor_registry.h>
+#include <shm_transport.h>
 
 /* Linux includes */
 #include <linux_syscalls.h>
@@ -100,6 +101,11 @@ namespace Genode {
 	 * sockets are closed.
 	 */
 	void destroy_server_socket_pair(Native_connection_state const &ncs);
+
+	/*
+	 * Helper to release the reply channel of a thread
+	 */
+	void destroy_reply_channel(Native_reply_channel &rc);
 }
 
 
@@ -301,112 +307,497 @@ static void extract_sds_from_message(unsigned start_index, Message const &msg,
 
 
 /**
- * Send request to server and wait for reply
+ * Return reply channel of the calling thread
+ *
+ * The main thread has no 'Thread_base' object. Hence, its reply channel is
+ * kept in a static variable.
  */
-static inline void lx_call(int dst_sd,
-                           Genode::Msgbuf_base &send_msgbuf, Genode::size_t send_msg_len,
-                           Genode::Msgbuf_base &recv_msgbuf)
+static Genode::Native_reply_channel &reply_channel_of_myself()
 {
-	int ret;
-	Message send_msg(send_msgbuf.buf, send_msg_len);
+	Genode::Thread_base *myself = Genode::Thread_base::myself();
+	if (myself)
+		return myself->tid().reply_channel;
 
-	/*
-	 * Create reply channel
-	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
-	 */
-	struct Reply_channel
-	{
-		enum { LOCAL_SOCKET = 0, REMOTE_SOCKET = 1 };
-		int sd[2];
+	static Genode::Native_reply_channel main_thread_reply_channel;
+	return main_thread_reply_channel;
+}
 
-		Reply_channel()
-		{
-			sd[LOCAL_SOCKET] = -1; sd[REMOTE_SOCKET] = -1;
 
-			int ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
-			if (ret < 0) {
-				PRAW("[%d] lx_socketpair failed with %d", lx_getpid(), ret);
-				throw Genode::Ipc_error();
-			}
-		}
+/**
+ * Create socket pair backing the reply channel
+ */
+static void create_reply_channel(Genode::Native_reply_channel &rc)
+{
+	int sd[2] = { -1, -1 };
 
-		~Reply_channel()
-		{
-			for (unsigned i = 0; i < 2; i++)
-			if (sd[0] != -1)
-				lx_close(sd[i]);
-		}
+	int ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
+	if (ret < 0) {
+		PRAW("[%d] lx_socketpair failed with %d", lx_getpid(), ret);
+		throw Genode::Ipc_error();
+	}
+
+	rc.local_sd  = sd[0];
+	rc.remote_sd = sd[1];
+}
+
+
+/**
+ * Release shared-memory connection
+ *
+ * The server reclaims the slot of the connection once it observes the
+ * 'DEAD' state.
+ */
+static void release_shm_connection(Genode::Native_shm_connection &c)
+{
+	using namespace Genode;
 
-		int local_socket()  const { return sd[LOCAL_SOCKET];  }
-		int remote_socket() const { return sd[REMOTE_SOCKET]; }
+	if (c.slot) {
+		shm_atomic_set(&c.slot->state, Shm_slot::DEAD);
+		lx_munmap(c.slot, SHM_SLOT_SIZE);
+	}
+	c = Native_shm_connection();
+}
 
-	} reply_channel;
 
-	/* assemble message */
+/**
+ * Close both ends of the reply channel
+ *
+ * The reply channel must be discarded whenever a call is aborted. Otherwise,
+ * a reply that arrives late would be mistaken for the reply of the next call.
+ * Because servers send replies of shared-memory connections to the reply
+ * channel, those connections are released along with the reply channel.
+ *
+ * This function is also called by the thread library on thread destruction.
+ */
+void Genode::destroy_reply_channel(Genode::Native_reply_channel &rc)
+{
+	if (!rc.valid())
+		return;
+
+	for (unsigned i = 0; i < Native_reply_channel::MAX_SHM_CONNECTIONS; i++)
+		release_shm_connection(rc.shm_connections[i]);
+
+	lx_close(rc.local_sd);
+	lx_close(rc.remote_sd);
+	rc = Genode::Native_reply_channel();
+}
+
+
+/**
+ * Receive reply from reply channel
+ */
+static void lx_recv_reply(Genode::Native_reply_channel &reply_channel,
+                          Genode::Msgbuf_base &recv_msgbuf)
+{
+	Message recv_msg(recv_msgbuf.buf, recv_msgbuf.size());
+	recv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
+
+	int ret = lx_recvmsg(reply_channel.local_sd, recv_msg.msg(), 0);
+
+	/* system call got interrupted by a signal */
+	if (ret == -LX_EINTR) {
+		destroy_reply_channel(reply_channel);
+		throw Genode::Blocking_canceled();
+	}
+
+	if (ret < 0) {
+		PRAW("[%d] lx_recvmsg failed with %d in lx_call()", lx_getpid(), ret);
+		destroy_reply_channel(reply_channel);
+		throw Genode::Ipc_error();
+	}
+
+	extract_sds_from_message(0, recv_msg, recv_msgbuf);
+}
+
+
+/**
+ * Send request to server via socket and wait for reply
+ */
+static void lx_call_socket(int dst_sd, Genode::Native_reply_channel &reply_channel,
+                           Genode::Msgbuf_base &send_msgbuf, Genode::size_t send_msg_len,
+                           Genode::Msgbuf_base &recv_msgbuf)
+{
+	Message send_msg(send_msgbuf.buf, send_msg_len);
 
 	/* marshal reply capability */
-	send_msg.marshal_socket(reply_channel.remote_socket());
+	send_msg.marshal_socket(reply_channel.remote_sd);
 
 	/* marshal capabilities contained in 'send_msgbuf' */
 	for (unsigned i = 0; i < send_msgbuf.used_caps(); i++)
 		send_msg.marshal_socket(send_msgbuf.cap(i));
 
-	ret = lx_sendmsg(dst_sd, send_msg.msg(), 0);
+	int ret = lx_sendmsg(dst_sd, send_msg.msg(), 0);
 	if (ret < 0) {
 		PRAW("[%d] lx_sendmsg to sd %d failed with %d in lx_call()",
 		     lx_getpid(), dst_sd, ret);
 		throw Genode::Ipc_error();
 	}
 
-	/* receive reply */
+	lx_recv_reply(reply_channel, recv_msgbuf);
+}
 
-	Message recv_msg(recv_msgbuf.buf, recv_msgbuf.size());
-	recv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
 
-	ret = lx_recvmsg(reply_channel.local_socket(), recv_msg.msg(), 0);
+/**
+ * Obtain identity of the socket referred to by 'sd'
+ */
+static bool socket_identity(int sd, unsigned long long *dev, unsigned long long *ino)
+{
+	struct stat64 st;
+	if (lx_fstat(sd, &st) < 0)
+		return false;
 
-	/* system call got interrupted by a signal */
-	if (ret == -LX_EINTR)
-		throw Genode::Blocking_canceled();
+	*dev = st.st_dev;
+	*ino = st.st_ino;
+	return true;
+}
 
-	if (ret < 0) {
-		PRAW("[%d] lx_recvmsg failed with %d in lx_call()", lx_getpid(), ret);
-		throw Genode::Ipc_error();
+
+/**
+ * Map shared memory received from the server
+ *
+ * \return  local address, or 0 on error
+ */
+static void *shm_attach(int fd, Genode::size_t size)
+{
+	if (fd < 0)
+		return 0;
+
+	void * const addr = lx_mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	lx_close(fd);
+
+	return shm_mmap_failed(addr) ? 0 : addr;
+}
+
+
+/**
+ * Request shared-memory connection from the entrypoint addressed by 'dst_sd'
+ *
+ * If the entrypoint refuses the connection, 'c' is left without slot, which
+ * prevents further connection attempts.
+ */
+static void shm_connect(int dst_sd, Genode::Native_reply_channel &reply_channel,
+                        Genode::Native_shm_connection &c)
+{
+	using namespace Genode;
+
+	Native_shm_connection refused;
+	refused.dst_sd = dst_sd;
+	if (!socket_identity(dst_sd, &refused.dst_dev, &refused.dst_ino))
+		return;
+
+	Msgbuf<sizeof(Shm_connect_reply)> send_msgbuf, recv_msgbuf;
+
+	/* the request consists of the server-local name and opcode only */
+	long const local_name = SHM_CONNECT_LOCAL_NAME;
+	int  const opcode     = 0;
+	Genode::memcpy(send_msgbuf.buf, &local_name, sizeof(local_name));
+	Genode::memcpy(send_msgbuf.buf + sizeof(local_name), &opcode, sizeof(opcode));
+
+	Genode::memset(recv_msgbuf.buf, 0, sizeof(Shm_connect_reply));
+
+	lx_call_socket(dst_sd, reply_channel, send_msgbuf,
+	               sizeof(local_name) + sizeof(opcode), recv_msgbuf);
+
+	Shm_connect_reply reply;
+	Genode::memcpy(&reply, recv_msgbuf.buf, sizeof(reply));
+
+	c = refused;
+
+	void * const slot = shm_attach(recv_msgbuf.read_cap(), SHM_SLOT_SIZE);
+
+	if (!slot || reply.exc_code || reply.slot < 0) {
+		if (slot) lx_munmap(slot, SHM_SLOT_SIZE);
+		return;
 	}
 
-	extract_sds_from_message(0, recv_msg, recv_msgbuf);
+	c.slot = (Shm_slot *)slot;
+}
+
+
+/**
+ * Wake up entrypoint that blocks on its socket
+ *
+ * If the socket buffer of the entrypoint is exhausted, the entrypoint has
+ * messages to process anyway. So the kick is not needed in this case.
+ */
+static void shm_kick(int dst_sd)
+{
+	long const local_name = Genode::SHM_KICK_LOCAL_NAME;
+	int  const opcode     = 0;
+
+	char buf[sizeof(local_name) + sizeof(opcode)];
+	Genode::memcpy(buf, &local_name, sizeof(local_name));
+	Genode::memcpy(buf + sizeof(local_name), &opcode, sizeof(opcode));
+
+	Message msg(buf, sizeof(buf));
+	lx_sendmsg(dst_sd, msg.msg(), MSG_DONTWAIT);
 }
 
 
 /**
- * for request from client
+ * Return shared-memory connection to the entrypoint addressed by 'dst_sd'
+ *
+ * The connection is established on first use. If all connection slots of
+ * the thread are occupied, one of them gets replaced. A connection is
+ * re-established if 'dst_sd' got closed and reused for another socket
+ * meanwhile.
+ */
+static Genode::Native_shm_connection &
+shm_connection(int dst_sd, Genode::Native_reply_channel &reply_channel)
+{
+	using namespace Genode;
+
+	enum { MAX = Native_reply_channel::MAX_SHM_CONNECTIONS };
+
+	Native_shm_connection *connections = reply_channel.shm_connections;
+
+	Native_shm_connection *c = 0;
+	for (unsigned i = 0; i < MAX && !c; i++)
+		if (connections[i].dst_sd == dst_sd)
+			c = &connections[i];
+
+	if (c) {
+		unsigned long long dev = 0, ino = 0;
+		if (socket_identity(dst_sd, &dev, &ino)
+		 && dev == c->dst_dev && ino == c->dst_ino)
+			return *c;
+
+	} else {
+
+		c = &connections[dst_sd % MAX];
+		for (unsigned i = 0; i < MAX; i++)
+			if (!connections[i].used()) {
+				c = &connections[i];
+				break;
+			}
+	}
+
+	release_shm_connection(*c);
+	shm_connect(dst_sd, reply_channel, *c);
+	return *c;
+}
+
+
+/**
+ * Send request to server via shared-memory connection and wait for reply
+ */
+static void lx_call_shm(Genode::Native_shm_connection &c,
+                        Genode::Native_reply_channel &reply_channel,
+                        Genode::Msgbuf_base &send_msgbuf, Genode::size_t send_msg_len,
+                        Genode::Msgbuf_base &recv_msgbuf)
+{
+	using namespace Genode;
+
+	Shm_slot &slot = *c.slot;
+
+	Genode::memcpy(slot.payload, send_msgbuf.buf, send_msg_len);
+	slot.len = send_msg_len;
+
+	/* publish the payload before the state change */
+	memory_barrier();
+
+	if (!cmpxchg(&slot.state, Shm_slot::IDLE, Shm_slot::REQUEST)) {
+		PRAW("[%d] unexpected state of shared-memory IPC slot", lx_getpid());
+		release_shm_connection(c);
+		throw Ipc_error();
+	}
+
+	/* make the request visible before looking at the doorbell */
+	memory_barrier();
+
+	if (slot.doorbell)
+		shm_kick(c.dst_sd);
+
+	int state;
+	while ((state = slot.state) == Shm_slot::REQUEST) {
+
+		int const ret = lx_futex((int *)&slot.state, LX_FUTEX_WAIT,
+		                         Shm_slot::REQUEST);
+
+		/* system call got interrupted by a signal */
+		if (ret == -LX_EINTR) {
+			destroy_reply_channel(reply_channel);
+			throw Blocking_canceled();
+		}
+	}
+
+	memory_barrier();
+
+	if (state == Shm_slot::REPLY_VIA_SOCKET) {
+		slot.state = Shm_slot::IDLE;
+		lx_recv_reply(reply_channel, recv_msgbuf);
+		return;
+	}
+
+	size_t len = slot.len;
+	if (len > Shm_slot::PAYLOAD_SIZE) len = Shm_slot::PAYLOAD_SIZE;
+	if (len > recv_msgbuf.size())     len = recv_msgbuf.size();
+
+	Genode::memcpy(recv_msgbuf.buf, slot.payload, len);
+	recv_msgbuf.reset_caps();
+
+	/* complete the reading of the payload before releasing the slot */
+	memory_barrier();
+
+	slot.state = Shm_slot::IDLE;
+}
+
+
+/**
+ * Send request to server and wait for reply
+ */
+static inline void lx_call(int dst_sd,
+                           Genode::Msgbuf_base &send_msgbuf, Genode::size_t send_msg_len,
+                           Genode::Msgbuf_base &recv_msgbuf)
+{
+	/*
+	 * Obtain reply channel
+	 *
+	 * The reply channel is created on the first call of the thread and
+	 * reused for all subsequent calls.
+	 */
+	Genode::Native_reply_channel &reply_channel = reply_channel_of_myself();
+	if (!reply_channel.valid())
+		create_reply_channel(reply_channel);
+
+	/* capabilities can be transferred via the socket only */
+	if (Genode::shm_transport_enabled() && send_msgbuf.used_caps() == 0
+	 && send_msg_len <= Genode::Shm_slot::PAYLOAD_SIZE) {
+
+		Genode::Native_shm_connection &c = shm_connection(dst_sd, reply_channel);
+		if (c.slot) {
+			lx_call_shm(c, reply_channel, send_msgbuf, send_msg_len, recv_msgbuf);
+			return;
+		}
+	}
+
+	lx_call_socket(dst_sd, reply_channel, send_msgbuf, send_msg_len, recv_msgbuf);
+}
+
+
+/**
+ * Return shared-memory transport of the calling entrypoint
+ *
+ * The main thread has no 'Thread_base' object. Hence, its transport is
+ * kept in a static variable.
+ */
+static Genode::Shm_server *&shm_server_of_myself()
+{
+	Genode::Thread_base *myself = Genode::Thread_base::myself();
+	if (myself)
+		return myself->tid().shm_server;
+
+	static Genode::Shm_server *main_thread_shm_server;
+	return main_thread_shm_server;
+}
+
+
+/**
+ * Handle request for establishing a shared-memory connection
+ *
+ * \return  shared-memory transport of the calling entrypoint, or 0 if the
+ *          transport could not be created
+ */
+static Genode::Shm_server *shm_accept(int reply_socket)
+{
+	using namespace Genode;
+
+	Shm_server *&shm = shm_server_of_myself();
+	if (!shm)
+		shm = Shm_server::create();
+
+	int slot_fd = -1;
+
+	Shm_connect_reply reply;
+	reply.scratch_word = 0;
+	reply.exc_code     = 0;
+	reply.slot         = shm ? shm->connect(reply_socket, &slot_fd) : -1;
+
+	Message msg(&reply, sizeof(reply));
+	if (reply.slot != -1)
+		msg.marshal_socket(slot_fd);
+
+	lx_sendmsg(reply_socket, msg.msg(), 0);
+
+	/* the client holds its own mapping of the slot */
+	if (slot_fd != -1)
+		lx_close(slot_fd);
+
+	/* on success, the connection keeps the reply socket */
+	if (reply.slot == -1)
+		lx_close(reply_socket);
+
+	return shm;
+}
+
+
+/**
+ * Wait for request from client
  *
  * \return  socket descriptor of reply capability
  */
 static inline int lx_wait(Genode::Native_connection_state &cs,
                           Genode::Msgbuf_base &recv_msgbuf)
 {
-	Message msg(recv_msgbuf.buf, recv_msgbuf.size());
+	Genode::Shm_server *shm = shm_server_of_myself();
 
-	msg.accept_sockets(Message::MAX_SDS_PER_MSG);
+	for (;;) {
 
-	int ret = lx_recvmsg(cs.server_sd, msg.msg(), 0);
+		/*
+		 * Look for requests posted via shared memory. Before blocking on
+		 * the socket, let the clients know that they have to kick us.
+		 */
+		if (shm) {
+			int const reply_socket = shm->fetch_request(recv_msgbuf);
+			if (reply_socket != -1)
+				return reply_socket;
 
-	/* system call got interrupted by a signal */
-	if (ret == -LX_EINTR)
-		throw Genode::Blocking_canceled();
+			if (!shm->ring_doorbells())
+				continue;
+		}
 
-	if (ret < 0) {
-		PRAW("lx_recvmsg failed with %d in lx_wait(), sd=%d", ret, cs.server_sd);
-		throw Genode::Ipc_error();
-	}
+		Message msg(recv_msgbuf.buf, recv_msgbuf.size());
+
+		msg.accept_sockets(Message::MAX_SDS_PER_MSG);
+
+		int ret = lx_recvmsg(cs.server_sd, msg.msg(), 0);
+
+		if (shm)
+			shm->silence_doorbells();
+
+		/* system call got interrupted by a signal */
+		if (ret == -LX_EINTR)
+			throw Genode::Blocking_canceled();
+
+		if (ret < 0) {
+			PRAW("lx_recvmsg failed with %d in lx_wait(), sd=%d", ret, cs.server_sd);
+			throw Genode::Ipc_error();
+		}
+
+		long local_name = 0;
+		Genode::memcpy(&local_name, recv_msgbuf.buf, sizeof(local_name));
 
-	int const reply_socket = msg.socket_at_index(0);
+		bool const shm_message = Genode::shm_transport_enabled()
+		                      && ret >= (int)sizeof(local_name);
+
+		/* a kick carries no sockets, drop any that were sent along anyway */
+		if (shm_message && local_name == Genode::SHM_KICK_LOCAL_NAME) {
+			for (unsigned i = 0; i < msg.num_sockets(); i++)
+				lx_close(msg.socket_at_index(i));
+			continue;
+		}
+
+		int const reply_socket = msg.socket_at_index(0);
+
+		if (shm_message && local_name == Genode::SHM_CONNECT_LOCAL_NAME) {
+			shm = shm_accept(reply_socket);
+			continue;
+		}
 
-	extract_sds_from_message(1, msg, recv_msgbuf);
+		extract_sds_from_message(1, msg, recv_msgbuf);
 
-	return reply_socket;
+		return reply_socket;
+	}
 }
 
 
@@ -417,6 +808,10 @@ static inline void lx_reply(int reply_socket,
                             Genode::Msgbuf_base &send_msgbuf,
                             Genode::size_t msg_len)
 {
+	Genode::Shm_server *shm = shm_server_of_myself();
+	if (shm && shm->reply_via_shm(reply_socket, send_msgbuf, msg_len))
+		return;
+
 	Message msg(send_msgbuf.buf, msg_len);
 
 	/*
@@ -427,6 +822,10 @@ static inline void lx_reply(int reply_socket,
 
 	int ret = lx_sendmsg(reply_socket, msg.msg(), 0);
 
+	/* reply sockets of shared-memory connections stay open */
+	if (shm && shm->reply_sent_via_socket(reply_socket))
+		return;
+
 	/* ignore reply send error caused by disappearing client */
 	if (ret >= 0 || ret == -LX_ECONNREFUSED) {
 		lx_close(reply_socket);
@@ -511,6 +910,12 @@ Ipc_istream::~Ipc_istream()
 		Thread_base *thread = Thread_base::myself();
 		if (thread)
 			thread->tid().is_ipc_server = false;
+
+		/* release shared-memory transport */
+		if (thread && thread->tid().shm_server) {
+			Shm_server::destroy(thread->tid().shm_server);
+			thread->tid().shm_server = 0;
+		}
 	}
 
 	destroy_server_socket_pair(_rcv_cs);
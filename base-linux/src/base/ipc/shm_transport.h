@@ -0,0 +1,450 @@
+/*
+ * \brief  Shared-memory transport for RPC messages on Linux
+ * \author agent
+ * \date   2026-10-17
+ *
+ * By default, each RPC message travels through the Unix-domain socket of the
+ * addressed entrypoint. With the shared-memory transport enabled, a client
+ * thread establishes a connection to an entrypoint on the first call. The
+ * entrypoint creates a message slot for the connection, which is backed by
+ * a memory file of its own. So a client can access the messages exchanged
+ * via its own connection only. Subsequent calls copy the message payload
+ * into the slot and signal the hand-off via futexes. The socket is used for
+ * the connection setup and for messages that carry capabilities (file
+ * descriptors) only.
+ *
+ * While no request is pending, the entrypoint blocks on its socket as
+ * usual. Before blocking, it rings the doorbell of each connection, which
+ * is a flag within the slot. A client that finds the doorbell rung after
+ * posting its request wakes up the entrypoint by sending a short 'kick'
+ * message to the socket. Because each connection has a doorbell of its own
+ * and kicks are queued at the socket, a client cannot suppress the wake-up
+ * caused by another client. It can merely cause spurious wake-ups.
+ *
+ * Replies that cannot be transferred via the slot, i.e., replies carrying
+ * capabilities and replies that are deferred by the server via 'omit_reply'
+ * and 'explicit_reply', are sent to the reply channel of the client thread.
+ * The server keeps the remote socket of the client's reply channel for this
+ * purpose and tells the client to receive the reply from the socket by
+ * setting the slot state to 'REPLY_VIA_SOCKET'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _BASE__IPC__SHM_TRANSPORT_H_
+#define _BASE__IPC__SHM_TRANSPORT_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+#include <base/ipc_msgbuf.h>
+#include <base/native_types.h>
+#include <cpu/atomic.h>
+
+/* Linux includes */
+#include <linux_syscalls.h>
+#include <sys/mman.h>
+
+
+namespace Genode {
+
+	/**
+	 * Return true if the shared-memory transport is enabled
+	 *
+	 * The function is implemented by either 'shm_transport_on.cc' or
+	 * 'shm_transport_off.cc', depending on whether 'lx_shm_ipc' is part of
+	 * the build's 'SPECS'.
+	 */
+	bool shm_transport_enabled();
+
+	/**
+	 * Server-local names of the messages of the shared-memory transport
+	 *
+	 * A connect request establishes a connection. A kick wakes up an
+	 * entrypoint that blocks on its socket.
+	 */
+	enum { SHM_CONNECT_LOCAL_NAME = -2, SHM_KICK_LOCAL_NAME = -3 };
+
+	/**
+	 * Reply message to a connection request
+	 *
+	 * On success, the reply carries the file descriptor of the slot
+	 * assigned to the connection.
+	 */
+	struct Shm_connect_reply
+	{
+		long scratch_word;
+		int  exc_code;
+		int  slot;   /* assigned slot, or -1 if the request got refused */
+	};
+
+	struct Shm_slot
+	{
+		enum State { FREE, IDLE, REQUEST, REPLY, REPLY_VIA_SOCKET, DEAD };
+
+		/*
+		 * The payload size corresponds to the message-buffer size of
+		 * 'Rpc_entrypoint'. Larger messages take the socket path.
+		 */
+		enum { PAYLOAD_SIZE = 1024 };
+
+		int   volatile state;
+		int   volatile doorbell;  /* set while the entrypoint blocks */
+		long  volatile len;
+		char           payload[PAYLOAD_SIZE];
+	};
+}
+
+
+enum { SHM_SLOT_SIZE = (sizeof(Genode::Shm_slot) + 0xfff) & ~0xfff };
+
+
+/**
+ * Order memory accesses to shared memory across CPUs
+ *
+ * The slot hand-off between client and server crosses process and CPU
+ * boundaries, so a compiler barrier is not sufficient on architectures
+ * with a weak memory model like ARM.
+ */
+static inline void memory_barrier() { __sync_synchronize(); }
+
+
+static inline void shm_atomic_set(int volatile *value, int new_value)
+{
+	for (int old = *value; !Genode::cmpxchg(value, old, new_value); old = *value);
+}
+
+
+static inline bool shm_mmap_failed(void *addr)
+{
+	return ((long)addr < 0) && ((long)addr > -4095);
+}
+
+
+/**
+ * Create and map memory file of the given size
+ *
+ * \return  file descriptor, or a negative value on error
+ */
+static inline int shm_create(char const *name, Genode::size_t size, void **addr)
+{
+	int const fd = lx_memfd_create(name, LX_MFD_CLOEXEC);
+	if (fd < 0)
+		return fd;
+
+	if (lx_ftruncate(fd, size) < 0) {
+		lx_close(fd);
+		return -1;
+	}
+
+	*addr = lx_mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (shm_mmap_failed(*addr)) {
+		lx_close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+
+/**
+ * Server-side state of the shared-memory transport of one entrypoint
+ *
+ * All functions must be called by the entrypoint thread.
+ */
+class Genode::Shm_server
+{
+	public:
+
+		enum { MAX_CONNECTIONS = 32 };
+
+	private:
+
+		struct Connection
+		{
+			int       reply_sd;  /* remote socket of client's reply channel */
+			unsigned  deferred;  /* number of outstanding deferred replies  */
+			Shm_slot *slot;
+
+			Connection() : reply_sd(-1), deferred(0), slot(0) { }
+
+			bool used() const { return reply_sd != -1; }
+		};
+
+		Connection    _connections[MAX_CONNECTIONS];
+		int           _curr_slot;   /* connection of request in progress, or -1 */
+		unsigned      _scan_start;  /* connection to look at first for requests */
+
+		void _release(unsigned i)
+		{
+			lx_close(_connections[i].reply_sd);
+			lx_munmap(_connections[i].slot, SHM_SLOT_SIZE);
+			_connections[i] = Connection();
+		}
+
+		/**
+		 * Return connection using the specified reply socket, or -1
+		 */
+		int _lookup(int reply_sd) const
+		{
+			if (reply_sd < 0)
+				return -1;
+
+			for (unsigned i = 0; i < MAX_CONNECTIONS; i++)
+				if (_connections[i].reply_sd == reply_sd)
+					return i;
+			return -1;
+		}
+
+		/**
+		 * Finish request of current slot by pointing the client to its
+		 * reply channel
+		 */
+		void _redirect_curr_reply_to_socket()
+		{
+			Shm_slot &slot = *_connections[_curr_slot].slot;
+			if (cmpxchg(&slot.state, Shm_slot::REQUEST, Shm_slot::REPLY_VIA_SOCKET))
+				lx_futex((int *)&slot.state, LX_FUTEX_WAKE, 1);
+
+			_curr_slot = -1;
+		}
+
+		Shm_server() : _curr_slot(-1), _scan_start(0) { }
+
+	public:
+
+		void *operator new (size_t, void *addr) { return addr; }
+
+		/**
+		 * Create shared-memory transport for entrypoint
+		 *
+		 * \return  new 'Shm_server' object, or 0 on error
+		 */
+		static Shm_server *create()
+		{
+			void * const object = lx_mmap(0, sizeof(Shm_server), PROT_READ | PROT_WRITE,
+			                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if (shm_mmap_failed(object)) {
+				PRAW("[%d] could not set up shared-memory IPC", lx_getpid());
+				return 0;
+			}
+
+			return new (object) Shm_server();
+		}
+
+		/**
+		 * Destroy shared-memory transport
+		 *
+		 * The connected clients notice the destruction of the entrypoint
+		 * when their next request via the socket fails.
+		 */
+		static void destroy(Shm_server *server)
+		{
+			for (unsigned i = 0; i < MAX_CONNECTIONS; i++)
+				if (server->_connections[i].used())
+					server->_release(i);
+
+			lx_munmap(server, sizeof(Shm_server));
+		}
+
+		/**
+		 * Create slot for new client
+		 *
+		 * \param reply_sd  remote socket of the client's reply channel
+		 * \param slot_fd   file descriptor of the new slot, to be passed to
+		 *                  the client and closed by the caller
+		 * \return          connection index, or -1 if no connection is
+		 *                  available
+		 *
+		 * On success, the server takes over the ownership of 'reply_sd'.
+		 * Each connection gets a new memory file. The slot of a vanished
+		 * client is never handed out again because the client may still
+		 * have it mapped.
+		 */
+		int connect(int reply_sd, int *slot_fd)
+		{
+			for (unsigned i = 0; i < MAX_CONNECTIONS; i++) {
+
+				if (_connections[i].used()) {
+
+					/* reclaim connection of vanished client */
+					if (_connections[i].slot->state != Shm_slot::DEAD
+					 || _connections[i].deferred)
+						continue;
+
+					_release(i);
+				}
+
+				void *slot = 0;
+				int const fd = shm_create("ipc_slot", SHM_SLOT_SIZE, &slot);
+				if (fd < 0)
+					return -1;
+
+				_connections[i].reply_sd = reply_sd;
+				_connections[i].slot     = (Shm_slot *)slot;
+				_connections[i].slot->state    = Shm_slot::IDLE;
+				_connections[i].slot->doorbell = 0;
+
+				*slot_fd = fd;
+				return i;
+			}
+			return -1;
+		}
+
+		/**
+		 * Fetch next pending request from the shared-memory slots
+		 *
+		 * \return  reply socket of the connection that issued the request,
+		 *          or -1 if no request is pending
+		 *
+		 * The slots are scanned round robin to serve busy clients fairly.
+		 */
+		int fetch_request(Msgbuf_base &rcv_msgbuf)
+		{
+			defer_curr_reply();
+
+			for (unsigned n = 0; n < MAX_CONNECTIONS; n++) {
+
+				unsigned const i = (_scan_start + n) % MAX_CONNECTIONS;
+
+				if (!_connections[i].used())
+					continue;
+
+				Shm_slot &slot = *_connections[i].slot;
+				int const state = slot.state;
+
+				if (state == Shm_slot::DEAD && !_connections[i].deferred) {
+					_release(i);
+					continue;
+				}
+
+				if (state != Shm_slot::REQUEST)
+					continue;
+
+				memory_barrier();
+
+				size_t len = slot.len;
+				if (len > Shm_slot::PAYLOAD_SIZE) len = Shm_slot::PAYLOAD_SIZE;
+				if (len > rcv_msgbuf.size())      len = rcv_msgbuf.size();
+
+				memcpy(rcv_msgbuf.buf, slot.payload, len);
+				rcv_msgbuf.reset_caps();
+
+				_curr_slot  = i;
+				_scan_start = i + 1;
+				return _connections[i].reply_sd;
+			}
+			return -1;
+		}
+
+		/**
+		 * Ring the doorbells before blocking on the socket
+		 *
+		 * \return  true if no request got posted in the meantime, i.e.,
+		 *          the entrypoint may block
+		 *
+		 * A client posts its request before looking at the doorbell. The
+		 * entrypoint rings the doorbells before looking for requests. So
+		 * either the entrypoint finds the request or the client finds the
+		 * doorbell rung and kicks the entrypoint.
+		 */
+		bool ring_doorbells()
+		{
+			for (unsigned i = 0; i < MAX_CONNECTIONS; i++)
+				if (_connections[i].used())
+					_connections[i].slot->doorbell = 1;
+
+			memory_barrier();
+
+			for (unsigned i = 0; i < MAX_CONNECTIONS; i++)
+				if (_connections[i].used()
+				 && _connections[i].slot->state == Shm_slot::REQUEST) {
+					silence_doorbells();
+					return false;
+				}
+			return true;
+		}
+
+		/**
+		 * Tell clients that the entrypoint does not block anymore
+		 */
+		void silence_doorbells()
+		{
+			for (unsigned i = 0; i < MAX_CONNECTIONS; i++)
+				if (_connections[i].used())
+					_connections[i].slot->doorbell = 0;
+		}
+
+		/**
+		 * Reply to the current request via its slot
+		 *
+		 * \return  true if the reply got delivered, false if the reply must
+		 *          be sent via the socket
+		 */
+		bool reply_via_shm(int reply_sd, Msgbuf_base &snd_msgbuf, size_t len)
+		{
+			if (_curr_slot == -1 || _connections[_curr_slot].reply_sd != reply_sd)
+				return false;
+
+			if (snd_msgbuf.used_caps() || len > Shm_slot::PAYLOAD_SIZE)
+				return false;
+
+			Shm_slot &slot = *_connections[_curr_slot].slot;
+			_curr_slot = -1;
+
+			memcpy(slot.payload, snd_msgbuf.buf, len);
+			slot.len = len;
+
+			/* publish the payload before the state change */
+			memory_barrier();
+
+			/* the state transition fails if the client vanished meanwhile */
+			if (cmpxchg(&slot.state, Shm_slot::REQUEST, Shm_slot::REPLY))
+				lx_futex((int *)&slot.state, LX_FUTEX_WAKE, 1);
+
+			return true;
+		}
+
+		/**
+		 * Account reply sent via the socket
+		 *
+		 * \return  true if 'reply_sd' belongs to a connection, in which case
+		 *          the socket must be kept open
+		 */
+		bool reply_sent_via_socket(int reply_sd)
+		{
+			int const i = _lookup(reply_sd);
+			if (i == -1)
+				return false;
+
+			if (i == _curr_slot)
+				_redirect_curr_reply_to_socket();
+			else if (_connections[i].deferred)
+				_connections[i].deferred--;
+
+			return true;
+		}
+
+		/**
+		 * Keep connection of current request alive for a deferred reply
+		 *
+		 * Called before receiving the next request. If the server left the
+		 * current request unanswered, it may still reply later using the
+		 * reply capability obtained via 'Rpc_entrypoint::reply_dst'. This
+		 * reply will be sent via the socket.
+		 */
+		void defer_curr_reply()
+		{
+			if (_curr_slot == -1)
+				return;
+
+			_connections[_curr_slot].deferred++;
+			_redirect_curr_reply_to_socket();
+		}
+};
+
+#endif /* _BASE__IPC__SHM_TRANSPORT_H_ */
@@ -0,0 +1,20 @@
+/*
+ * \brief  Shared-memory RPC transport disabled
+ * \author agent
+ * \date   2026-10-17
+ *
+ * This file is used unless 'lx_shm_ipc' is among the SPECS.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* local includes */
+#include <shm_transport.h>
+
+
+bool Genode::shm_transport_enabled() { return false; }
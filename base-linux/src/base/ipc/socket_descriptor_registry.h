@@ -8,6 +8,17 @@
  * lookup the corresponding entrypoint ID. If we already possess a socket
  * descriptor pointing to the same entrypoint, we close the received one and
  * use the already known descriptor instead.
+ *
+ * The registry is indexed by socket descriptor and, via a hash table, by
+ * global ID. So both kinds of lookups take constant time. Because socket
+ * descriptors are small integers, the entry of a socket descriptor is
+ * located directly at the index of the descriptor. The entries of one hash
+ * bucket are chained through their 'next' members.
+ *
+ * The registry starts with a statically allocated table and grows on
+ * demand using anonymous memory obtained directly from the kernel. It
+ * cannot use the heap because sockets are registered while the environment
+ * of the process is being constructed.
  */
 
 /*
@@ -22,13 +33,16 @@
 
 #include <base/lock.h>
 
+/* Linux includes */
+#include <linux_syscalls.h>
+
 
 namespace Genode
 {
-	template <unsigned MAX_FDS>
+	template <unsigned INITIAL_CAPACITY>
 	class Socket_descriptor_registry;
 
-	typedef Socket_descriptor_registry<100> Ep_socket_descriptor_registry;
+	typedef Socket_descriptor_registry<256> Ep_socket_descriptor_registry;
 
 	/**
 	 * Return singleton instance of registry for tracking entrypoint sockets
@@ -37,7 +51,14 @@ namespace Genode
 }
 
 
-template <unsigned MAX_FDS>
+/**
+ * Socket-descriptor registry
+ *
+ * \param INITIAL_CAPACITY  number of socket descriptors that can be
+ *                          registered without growing the registry, must
+ *                          be a power of two
+ */
+template <unsigned INITIAL_CAPACITY>
 class Genode::Socket_descriptor_registry
 {
 	public:
@@ -45,45 +66,106 @@ class Genode::Socket_descriptor_registry
 		class Limit_reached { };
 		class Aliased_global_id { };
 
+		/**
+		 * Upper bound of socket-descriptor values, must be a power of two
+		 */
+		enum { MAX_CAPACITY = 1 << 20 };
+
 	private:
 
 		struct Entry
 		{
-			int fd;
 			int global_id;
+			int next;       /* next socket descriptor of the same bucket */
 
 			/**
 			 * Default constructor creates empty entry
 			 */
-			Entry() : fd(-1), global_id(-1) { }
-
-			Entry(int fd, int global_id) : fd(fd), global_id(global_id) { }
+			Entry() : global_id(-1), next(-1) { }
 
-			bool is_free() const { return fd == -1; }
-
-			void mark_as_free() { fd = -1; }
+			bool is_free() const { return global_id == -1; }
 		};
 
-		Entry _entries[MAX_FDS];
+		Entry _initial_entries[INITIAL_CAPACITY];
+		int   _initial_buckets[INITIAL_CAPACITY];
+
+		Entry   *_entries;    /* entries indexed by socket descriptor */
+		int     *_buckets;    /* first socket descriptor of each bucket */
+		unsigned _capacity;   /* number of entries and buckets */
 
 		Genode::Lock mutable _lock;
 
-		Entry &_find_free_entry()
+		int &_bucket(int global_id) const
 		{
-			for (unsigned i = 0; i < MAX_FDS; i++)
-				if (_entries[i].is_free())
-					return _entries[i];
+			unsigned h = global_id;
+			h ^= h >> 16;
+			h *= 0x45d9f3b;
+			h ^= h >> 16;
+			return _buckets[h & (_capacity - 1)];
+		}
+
+		/**
+		 * Enlarge registry to accommodate the socket descriptor 'sd'
+		 *
+		 * \throw Limit_reached
+		 */
+		void _grow(int sd)
+		{
+			unsigned capacity = _capacity;
+			while (capacity <= (unsigned)sd && capacity < MAX_CAPACITY)
+				capacity *= 2;
+
+			if (capacity <= (unsigned)sd)
+				throw Limit_reached();
+
+			enum { LX_PROT_READ  = 0x1, LX_PROT_WRITE     = 0x2,
+			       LX_MAP_PRIVATE = 0x2, LX_MAP_ANONYMOUS = 0x20 };
+
+			Genode::size_t const size = capacity*(sizeof(Entry) + sizeof(int));
+
+			void * const mem = lx_mmap(0, size, LX_PROT_READ | LX_PROT_WRITE,
+			                           LX_MAP_PRIVATE | LX_MAP_ANONYMOUS, -1, 0);
+			if (((long)mem < 0) && ((long)mem > -4095))
+				throw Limit_reached();
+
+			Entry * const  old_entries  = _entries;
+			unsigned const old_capacity = _capacity;
+
+			_entries  = (Entry *)mem;
+			_buckets  = (int *)(_entries + capacity);
+			_capacity = capacity;
 
-			throw Limit_reached();
+			for (unsigned i = 0; i < capacity; i++) {
+				_entries[i] = Entry();
+				_buckets[i] = -1;
+			}
+
+			/* re-insert existing entries */
+			for (unsigned i = 0; i < old_capacity; i++)
+				if (!old_entries[i].is_free())
+					_insert(i, old_entries[i].global_id);
+
+			if (old_entries != _initial_entries)
+				lx_munmap(old_entries, old_capacity*(sizeof(Entry) + sizeof(int)));
 		}
 
-		Entry &_find_entry_by_fd(int fd)
+		void _insert(int sd, int global_id)
 		{
-			for (unsigned i = 0; i < MAX_FDS; i++)
-				if (_entries[i].fd == fd)
-					return _entries[i];
+			int &first = _bucket(global_id);
 
-			throw Limit_reached();
+			_entries[sd].global_id = global_id;
+			_entries[sd].next      = first;
+			first = sd;
+		}
+
+		void _remove(int sd)
+		{
+			int *link = &_bucket(_entries[sd].global_id);
+			while (*link != sd)
+				link = &_entries[*link].next;
+
+			*link = _entries[sd].next;
+			_entries[sd] = Entry();
 		}
 
 		/**
@@ -93,24 +175,36 @@ class Genode::Socket_descriptor_registry
 		 */
 		int _lookup_fd_by_global_id(int global_id) const
 		{
-			for (unsigned i = 0; i < MAX_FDS; i++)
-				if (_entries[i].global_id == global_id)
-					return _entries[i].fd;
+			for (int sd = _bucket(global_id); sd != -1; sd = _entries[sd].next)
+				if (_entries[sd].global_id == global_id)
+					return sd;
 
 			return -1;
 		}
 
 	public:
 
+		Socket_descriptor_registry()
+		:
+			_entries(_initial_entries), _buckets(_initial_buckets),
+			_capacity(INITIAL_CAPACITY)
+		{
+			for (unsigned i = 0; i < INITIAL_CAPACITY; i++)
+				_initial_buckets[i] = -1;
+		}
+
+		~Socket_descriptor_registry()
+		{
+			if (_entries != _initial_entries)
+				lx_munmap(_entries, _capacity*(sizeof(Entry) + sizeof(int)));
+		}
+
 		void disassociate(int sd)
 		{
 			Genode::Lock::Guard guard(_lock);
 
-			for (unsigned i = 0; i < MAX_FDS; i++)
-				if (_entries[i].fd == sd) {
-					_entries[i].mark_as_free();
-					return;
-				}
+			if (sd >= 0 && (unsigned)sd < _capacity && !_entries[sd].is_free())
+				_remove(sd);
 		}
 
 		/**
@@ -126,24 +220,24 @@ class Genode::Socket_descriptor_registry
 		int try_associate(int sd, int global_id)
 		{
 			/* ignore invalid capabilities */
-			if (sd == -1)
-				return sd;
-
-			/* ignore invalid capabilities */
-			if (sd == -1 || global_id == -1)
+			if (sd < 0 || global_id == -1)
 				return sd;
 
 			Genode::Lock::Guard guard(_lock);
 
 			int const existing_sd = _lookup_fd_by_global_id(global_id);
-
-			if (existing_sd < 0) {
-				Entry &entry = _find_free_entry();
-				entry = Entry(sd, global_id);
-				return sd;
-			} else {
+			if (existing_sd >= 0)
 				return existing_sd;
-			}
+
+			if ((unsigned)sd >= _capacity)
+				_grow(sd);
+
+			/* drop stale association of a socket descriptor that got reused */
+			if (!_entries[sd].is_free())
+				_remove(sd);
+
+			_insert(sd, global_id);
+			return sd;
 		}
 };
 
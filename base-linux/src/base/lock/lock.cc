@@ -0,0 +1,106 @@
+/*
+ * \brief  Futex-based lock implementation for Linux
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The lock follows the well-known three-state futex protocol. In contrast
+ * to the generic lock implementation, a contending thread does not enqueue
+ * itself into an applicant list protected by a spinlock that is acquired
+ * via 'thread_yield', but blocks on the futex word directly. The kernel
+ * maintains the queue of blocked threads and 'unlock' wakes up exactly one
+ * of them.
+ *
+ * Before blocking, a thread spins for a short while because critical
+ * sections are usually short. This way, the lock is often handed over
+ * without involving the kernel at all.
+ *
+ * The cancel-blocking mechanism of Linux sends a signal to the blocked
+ * thread, which interrupts the futex system call. This condition is
+ * reflected as 'Blocking_canceled' exception.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/cancelable_lock.h>
+#include <cpu/atomic.h>
+
+/* local includes */
+#include <lock_helper.h>
+#include <lock_trace.h>
+
+using namespace Genode;
+
+
+/**
+ * Number of attempts to grab a contended lock before blocking
+ */
+enum { SPIN_COUNT = 100 };
+
+
+void Cancelable_lock::lock()
+{
+	/* uncontended case */
+	if (cmpxchg(&_futex, FREE, TAKEN))
+		return;
+
+	/* wait for the lock holder to leave the critical section */
+	for (unsigned i = 0; i < SPIN_COUNT; i++) {
+		cpu_relax();
+		if (_futex == FREE && cmpxchg(&_futex, FREE, TAKEN))
+			return;
+	}
+
+	Trace::Timestamp const blocked = lock_contention_start();
+
+	for (;;) {
+
+		int const state = _futex;
+
+		/*
+		 * Once we blocked, we cannot know whether further threads are
+		 * blocking. Hence, we grab the lock in 'CONTENDED' state to make the
+		 * next 'unlock' wake up one of them.
+		 */
+		if (state == FREE) {
+			if (!cmpxchg(&_futex, FREE, CONTENDED))
+				continue;
+
+			lock_contention_end(this, blocked);
+			return;
+		}
+
+		/* tell the lock holder that we are about to block */
+		if (state == TAKEN && !cmpxchg(&_futex, TAKEN, CONTENDED))
+			continue;
+
+		if (!thread_wait_on_futex(&_futex, CONTENDED))
+			throw Blocking_canceled();
+	}
+}
+
+
+void Cancelable_lock::unlock()
+{
+	/* nobody is blocking */
+	if (cmpxchg(&_futex, TAKEN, FREE))
+		return;
+
+	/*
+	 * Only the lock holder changes the state away from 'CONTENDED'. So the
+	 * exchange always succeeds. We use it as memory barrier.
+	 */
+	cmpxchg(&_futex, CONTENDED, FREE);
+	thread_wake_one_on_futex(&_futex);
+}
+
+
+Cancelable_lock::Cancelable_lock(Cancelable_lock::State initial)
+:
+	_futex(initial == LOCKED ? TAKEN : FREE)
+{ }
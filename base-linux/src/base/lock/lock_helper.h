@@ -3,11 +3,9 @@
  * \author Norman Feske
  * \date   2009-07-20
  *
- * This file serves as adapter between the generic lock implementation
- * in 'lock.cc' and the underlying kernel.
- *
- * For documentation about the interface, please revisit the 'base-pistachio'
- * implementation.
+ * This file serves as adapter between the futex-based lock implementation
+ * in 'lock.cc' and the underlying kernel. The 'thread_yield' function is also
+ * used by the generic spinlock.
  */
 
 /*
@@ -25,9 +23,6 @@
 #include <linux_syscalls.h>
 
 
-extern int main_thread_futex_counter;
-
-
 /**
  * Resolve 'Thread_base::myself' when not linking the thread library
  *
@@ -45,31 +40,36 @@ static inline void thread_yield()
 }
 
 
-static inline bool thread_check_stopped_and_restart(Genode::Thread_base *thread_base)
+/**
+ * Hint the CPU that we are spinning on a memory location
+ */
+static inline void cpu_relax()
 {
-	const int *futex_counter_ptr = thread_base ?
-	                               &thread_base->tid().futex_counter :
-	                               &main_thread_futex_counter;
-	return lx_futex(futex_counter_ptr, LX_FUTEX_WAKE, 1);
+#if defined(__i386__) || defined(__x86_64__)
+	asm volatile ("pause" : : : "memory");
+#else
+	asm volatile ("" : : : "memory");
+#endif
 }
 
 
-static inline void thread_switch_to(Genode::Thread_base *thread_base)
+/**
+ * Block on futex word as long as it has the specified value
+ *
+ * \return false if the blocking was interrupted by the cancel-blocking
+ *         signal
+ */
+static inline bool thread_wait_on_futex(volatile int *futex, int value)
 {
-	thread_yield();
+	enum { LX_EINTR = 4 };
+	return lx_futex((int *)futex, LX_FUTEX_WAIT_PRIVATE, value) != -LX_EINTR;
 }
 
 
-static inline void thread_stop_myself()
+/**
+ * Wake up one thread blocking on futex word
+ */
+static inline void thread_wake_one_on_futex(volatile int *futex)
 {
-	/*
-	 * Just go to sleep without modifying the counter value. The
-	 * 'thread_check_stopped_and_restart()' function will get called
-	 * repeatedly until this thread has actually executed the syscall.
-	 */
-	Genode::Thread_base *myself = Genode::Thread_base::myself();
-	const int *futex_counter_ptr = myself ?
-	                               &myself->tid().futex_counter :
-	                               &main_thread_futex_counter;
-	lx_futex(futex_counter_ptr, LX_FUTEX_WAIT, 0);
+	lx_futex((int *)futex, LX_FUTEX_WAKE_PRIVATE, 1);
 }
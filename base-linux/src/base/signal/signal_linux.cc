@@ -0,0 +1,413 @@
+/*
+ * \brief  Direct delivery of signals between Linux processes
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The signal-handler thread of each process obtains a bound socket pair
+ * from core once. All signal-context capabilities of the process refer to
+ * the client-side socket of this pair. Submitting a signal is a single
+ * 'sendmsg' from the transmitter to the receiving process. Core is only
+ * consulted for allocating and freeing signal contexts.
+ *
+ * A transmitter never blocks on the socket of a receiver. If the socket
+ * buffer of the receiver is exhausted, the submission is recorded as
+ * pending and delivered by a separate thread of the transmitter later on.
+ * This thread does not block on a single receiver either. Further
+ * submissions to a context with a pending signal are merged into the
+ * pending signal. If too many signals are pending, new ones are dropped.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/thread.h>
+#include <signal_session/client.h>
+
+/* Linux includes */
+#include <linux_syscalls.h>
+#include <sys/socket.h>
+#include <poll.h>
+
+
+namespace Genode {
+
+	/*
+	 * Helper for obtaining a bound and connected socket pair, implemented
+	 * by the IPC support of core and non-core processes
+	 */
+	Native_connection_state server_socket_pair();
+}
+
+
+using namespace Genode;
+
+
+enum { LX_EINTR = 4, LX_EAGAIN = 11 };
+
+
+namespace {
+
+	/**
+	 * Message transferred for each signal submission
+	 */
+	struct Signal_datagram
+	{
+		long     imprint;
+		unsigned num;
+	};
+}
+
+
+/**
+ * Return socket descriptor referring to the signal-handler thread
+ *
+ * The socket descriptor is initialized by the signal-handler thread before
+ * any signal context can be allocated.
+ */
+static int &signal_client_sd()
+{
+	static int sd = -1;
+	return sd;
+}
+
+
+static int send_signal(int sd, Signal_datagram &datagram, int flags)
+{
+	iovec iov;
+	iov.iov_base = &datagram;
+	iov.iov_len  = sizeof(datagram);
+
+	msghdr msg;
+	Genode::memset(&msg, 0, sizeof(msg));
+	msg.msg_iov    = &iov;
+	msg.msg_iovlen = 1;
+
+	int ret;
+	while ((ret = lx_sendmsg(sd, &msg, flags | MSG_NOSIGNAL)) == -LX_EINTR);
+	return ret;
+}
+
+
+/**
+ * Thread for delivering signals that could not be sent immediately
+ */
+class Signal_retransmitter : Thread<4*1024*sizeof(addr_t)>
+{
+	private:
+
+		enum { MAX_PENDING = 64 };
+
+		/*
+		 * Interval of re-checking the pending signals while waiting for
+		 * receivers to drain their sockets, so that signals recorded in the
+		 * meantime are not delayed any longer
+		 */
+		enum { RETRY_INTERVAL_MS = 10 };
+
+		/**
+		 * Pending signal
+		 *
+		 * The entry keeps a duplicate of the socket descriptor of the
+		 * receiver. So the datagram cannot go astray if the original
+		 * descriptor gets closed and its number reused. Merging is based on
+		 * the identity of the socket rather than the descriptor number.
+		 */
+		struct Pending
+		{
+			int                sd;
+			unsigned long long dev, ino;
+			Signal_datagram    datagram;
+		};
+
+		Lock     _lock;
+		Lock     _wakeup;
+		Pending  _pending[MAX_PENDING];
+		unsigned _num_pending;
+		unsigned _num_dropped;
+
+		static bool _socket_identity(int sd, unsigned long long *dev,
+		                             unsigned long long *ino)
+		{
+			struct stat64 st;
+			if (lx_fstat(sd, &st) < 0)
+				return false;
+
+			*dev = st.st_dev;
+			*ino = st.st_ino;
+			return true;
+		}
+
+		void _remove(unsigned i)
+		{
+			lx_close(_pending[i].sd);
+			_pending[i] = _pending[--_num_pending];
+		}
+
+		/**
+		 * Try to send each pending signal without blocking
+		 *
+		 * eturn  true if signals remain pending
+		 */
+		bool _deliver()
+		{
+			Lock::Guard guard(_lock);
+
+			for (unsigned i = 0; i < _num_pending; ) {
+
+				int const ret = send_signal(_pending[i].sd, _pending[i].datagram,
+				                            MSG_DONTWAIT);
+				if (ret == -LX_EAGAIN) {
+					i++;
+					continue;
+				}
+
+				if (ret < 0)
+					PDBG("could not deliver signal, ret=%d", ret);
+
+				_remove(i);
+			}
+			return _num_pending != 0;
+		}
+
+		/**
+		 * Wait until one of the receivers of pending signals can take data
+		 */
+		void _wait_for_receivers()
+		{
+			pollfd   fds[MAX_PENDING];
+			unsigned num_fds = 0;
+			{
+				Lock::Guard guard(_lock);
+
+				for (; num_fds < _num_pending; num_fds++) {
+					fds[num_fds].fd      = _pending[num_fds].sd;
+					fds[num_fds].events  = POLLOUT;
+					fds[num_fds].revents = 0;
+				}
+			}
+
+			/*
+			 * The duplicated descriptors stay open while polling because only
+			 * this thread removes pending signals.
+			 */
+			lx_poll(fds, num_fds, RETRY_INTERVAL_MS);
+		}
+
+		void entry()
+		{
+			for (;;) {
+				_wakeup.lock();
+
+				while (_deliver())
+					_wait_for_receivers();
+			}
+		}
+
+	public:
+
+		Signal_retransmitter()
+		:
+			Thread<4*1024*sizeof(addr_t)>("signal retransmitter"),
+			_wakeup(Lock::LOCKED), _num_pending(0), _num_dropped(0)
+		{
+			start();
+		}
+
+		/**
+		 * Merge signal into the pending signal of the same context
+		 *
+		 * \param new_entry  if true, a new pending signal is created if the
+		 *                   context has no pending signal yet
+		 * eturn           true if the signal got recorded
+		 *
+		 * If 'new_entry' is true and the table of pending signals is full,
+		 * the signal is dropped and accounted as such. The function never
+		 * blocks on the receiver.
+		 */
+		bool merge(int sd, Signal_datagram const &datagram, bool new_entry)
+		{
+			Lock::Guard guard(_lock);
+
+			if (!_num_pending && !new_entry)
+				return false;
+
+			unsigned long long dev = 0, ino = 0;
+			if (!_socket_identity(sd, &dev, &ino))
+				return false;
+
+			for (unsigned i = 0; i < _num_pending; i++)
+				if (_pending[i].dev == dev && _pending[i].ino == ino
+				 && _pending[i].datagram.imprint == datagram.imprint) {
+					_pending[i].datagram.num += datagram.num;
+					return true;
+				}
+
+			if (!new_entry)
+				return false;
+
+			int const dup_sd = _num_pending < MAX_PENDING ? lx_dup(sd) : -1;
+			if (dup_sd < 0) {
+				_num_dropped++;
+				PDBG("too many pending signals, dropped %u so far", _num_dropped);
+				return true;
+			}
+
+			_pending[_num_pending].sd       = dup_sd;
+			_pending[_num_pending].dev      = dev;
+			_pending[_num_pending].ino      = ino;
+			_pending[_num_pending].datagram = datagram;
+			_num_pending++;
+
+			_wakeup.unlock();
+			return true;
+		}
+};
+
+
+/**
+ * Return retransmitter, or 0 if it has not been needed so far
+ *
+ * \param create  create retransmitter if it does not exist yet
+ */
+static Signal_retransmitter *signal_retransmitter(bool create)
+{
+	static Signal_retransmitter * volatile retransmitter;
+
+	if (!retransmitter && create) {
+		static Signal_retransmitter inst;
+		retransmitter = &inst;
+	}
+	return retransmitter;
+}
+
+
+/***************************
+ ** Signal-session client **
+ ***************************/
+
+Signal_context_capability Signal_session_client::alloc_context(long imprint)
+{
+	/* let core account the context */
+	Signal_context_capability const core_cap = call<Rpc_alloc_context>(imprint);
+
+	Context *context = new (env()->heap()) Context(imprint, core_cap);
+	{
+		Lock::Guard guard(_contexts_lock);
+		_contexts.insert(context);
+	}
+
+	Native_capability const direct_cap(Cap_dst_policy::Dst(signal_client_sd()),
+	                                   imprint);
+
+	return reinterpret_cap_cast<Signal_context>(direct_cap);
+}
+
+
+void Signal_session_client::free_context(Signal_context_capability cap)
+{
+	Context *context = 0;
+	{
+		Lock::Guard guard(_contexts_lock);
+
+		for (context = _contexts.first(); context; context = context->next())
+			if (context->imprint == cap.local_name())
+				break;
+
+		if (context)
+			_contexts.remove(context);
+	}
+
+	if (!context) {
+		PWRN("attempt to free unknown signal context");
+		return;
+	}
+
+	call<Rpc_free_context>(context->core_cap);
+	destroy(env()->heap(), context);
+}
+
+
+void Signal_session_client::submit(Signal_context_capability cap, unsigned cnt)
+{
+	if (!cap.valid())
+		return;
+
+	int const sd = cap.dst().socket;
+
+	Signal_datagram datagram;
+	datagram.imprint = cap.local_name();
+	datagram.num     = cnt;
+
+	/* merge signal into pending signal of the context */
+	Signal_retransmitter *retransmitter = signal_retransmitter(false);
+	if (retransmitter && retransmitter->merge(sd, datagram, false))
+		return;
+
+	int ret = send_signal(sd, datagram, MSG_DONTWAIT);
+
+	/*
+	 * If the socket buffer of the receiver is exhausted, leave the delivery
+	 * to the retransmitter.
+	 */
+	if (ret == -LX_EAGAIN && signal_retransmitter(true)->merge(sd, datagram, true))
+		return;
+
+	/*
+	 * A failed submission means that the receiver has vanished. We do not
+	 * use PWRN() to enable the build system to suppress this message in
+	 * release mode (SPECS += release).
+	 */
+	if (ret < 0)
+		PDBG("could not deliver signal, ret=%d", ret);
+}
+
+
+/**************************
+ ** Signal-source client **
+ **************************/
+
+Signal_source_client::Signal_source_client(Signal_source_capability cap)
+:
+	Rpc_client<Signal_source>(cap), _server_sd(-1)
+{
+	Native_connection_state const ncs = server_socket_pair();
+
+	_server_sd         = ncs.server_sd;
+	signal_client_sd() = ncs.client_sd;
+}
+
+
+Signal_source::Signal Signal_source_client::wait_for_signal()
+{
+	for (;;) {
+		Signal_datagram datagram;
+
+		iovec iov;
+		iov.iov_base = &datagram;
+		iov.iov_len  = sizeof(datagram);
+
+		msghdr msg;
+		Genode::memset(&msg, 0, sizeof(msg));
+		msg.msg_iov    = &iov;
+		msg.msg_iovlen = 1;
+
+		int const ret = lx_recvmsg(_server_sd, &msg, 0);
+
+		if (ret == -LX_EINTR)
+			continue;
+
+		if (ret != sizeof(datagram)) {
+			PWRN("received malformed signal datagram, ret=%d", ret);
+			continue;
+		}
+
+		return Signal(datagram.imprint, datagram.num);
+	}
+}
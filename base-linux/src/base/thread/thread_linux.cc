@@ -24,6 +24,15 @@
 using namespace Genode;
 
 
+namespace Genode {
+
+	/*
+	 * Helper to release the reply channel of a thread, defined in 'ipc.cc'
+	 */
+	void destroy_reply_channel(Native_reply_channel &rc);
+}
+
+
 static void empty_signal_handler(int) { }
 
 
@@ -99,6 +108,9 @@ void Thread_base::_deinit_platform_thread()
 		lx_nanosleep(&ts, 0);
 	}
 
+	/* release the reply channel used by the thread's RPC calls */
+	destroy_reply_channel(_tid.reply_channel);
+
 	/* inform core about the killed thread */
 	env()->cpu_session()->kill_thread(_thread_cap);
 }
@@ -79,6 +79,12 @@ namespace Genode {
 				RAM_SESSION_IMPL::free(ds);
 			}
 
+			Ram_dataspace_capability clone(Ram_dataspace_capability ds)
+			{
+				Lock::Guard lock_guard(_lock);
+				return RAM_SESSION_IMPL::clone(ds);
+			}
+
 			int ref_account(Ram_session_capability session)
 			{
 				Lock::Guard lock_guard(_lock);
@@ -29,15 +29,35 @@ inline int lx_mkdir(char const *pathname, mode_t mode)
 }
 
 
-inline int lx_ftruncate(int fd, unsigned long length)
+inline int lx_unlink(const char *fname)
 {
-	return lx_syscall(SYS_ftruncate, fd, length);
+	return lx_syscall(SYS_unlink, fname);
 }
 
 
-inline int lx_unlink(const char *fname)
+enum { LX_SEEK_DATA = 3, LX_SEEK_HOLE = 4 };
+
+inline long lx_lseek(int fd, long offset, int whence)
 {
-	return lx_syscall(SYS_unlink, fname);
+	return lx_syscall(SYS_lseek, fd, offset, whence);
+}
+
+
+/**
+ * Copy file content within the kernel
+ *
+ * \return number of copied bytes, or negative error code
+ */
+inline long lx_copy_file_range(int fd_in, long long *off_in,
+                               int fd_out, long long *off_out,
+                               Genode::size_t len)
+{
+#ifdef SYS_copy_file_range
+	return lx_syscall(SYS_copy_file_range, fd_in, off_in, fd_out, off_out, len, 0);
+#else
+	enum { LX_ENOSYS = 38 };
+	return -LX_ENOSYS;
+#endif
 }
 
 
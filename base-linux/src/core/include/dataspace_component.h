@@ -41,6 +41,7 @@ namespace Genode {
 			Filename       _fname;              /* filename for mmap          */
 			int            _fd;                 /* file descriptor            */
 			bool           _writable;           /* false if read-only         */
+			bool           _huge_pages;         /* map using huge pages       */
 
 			/* Holds the dataspace owner if a distinction between owner and
 			 * others is necessary on the dataspace, otherwise it is 0 */
@@ -55,13 +56,14 @@ namespace Genode {
 			                    bool /* write_combined */, bool writable,
 			                    Dataspace_owner * owner)
 			: _size(size), _addr(addr), _fd(-1), _writable(writable),
-			  _owner(owner) { }
+			  _huge_pages(false), _owner(owner) { }
 
 			/**
 			 * Default constructor returns invalid dataspace
 			 */
 			Dataspace_component()
-			: _size(0), _addr(0), _fd(-1), _writable(false), _owner(0) { }
+			: _size(0), _addr(0), _fd(-1), _writable(false), _huge_pages(false),
+			  _owner(0) { }
 
 			/**
 			 * This constructor is only provided for compatibility
@@ -71,7 +73,8 @@ namespace Genode {
 			                    addr_t phys_addr, bool write_combined,
 			                    bool writable, Dataspace_owner * _owner)
 			:
-				_size(size), _addr(phys_addr), _fd(-1), _owner(_owner)
+				_size(size), _addr(phys_addr), _fd(-1), _huge_pages(false),
+				_owner(_owner)
 			{
 				PWRN("Should only be used for IOMEM and not within Linux.");
 				_fname.buf[0] = 0;
@@ -93,11 +96,28 @@ namespace Genode {
 			 */
 			void fd(int fd) { _fd = fd; }
 
+			/**
+			 * Request the dataspace to be mapped using huge pages
+			 */
+			void huge_pages(bool huge_pages) { _huge_pages = huge_pages; }
+
 			/**
 			 * Check if dataspace is owned by a specified object
 			 */
 			bool owner(Dataspace_owner * const o) const { return _owner == o; }
 
+			/**
+			 * Return false as the caching attribute is not supported on Linux
+			 */
+			bool write_combined() const { return false; }
+
+			/*
+			 * Core-local mappings of dataspaces are not used on Linux. The
+			 * functions are provided for the generic RAM-session code only.
+			 */
+			addr_t core_local_addr() const { return 0; }
+			void   assign_core_local_addr(void *) { }
+
 			/*************************
 			 ** Dataspace interface **
 			 *************************/
@@ -113,6 +133,8 @@ namespace Genode {
 
 			Filename fname() { return _fname; }
 
+			bool huge_pages() { return _huge_pages; }
+
 			Untyped_capability fd()
 			{
 				typedef Untyped_capability::Dst Dst;
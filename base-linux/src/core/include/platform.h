@@ -92,6 +92,12 @@ namespace Genode {
 			Rom_fs          *rom_fs()         { return 0; }
 
 			void wait_for_exit();
+
+			/*
+			 * Memory files are zeroed by the Linux kernel, there is no need
+			 * for a pool of pre-zeroed memory.
+			 */
+			size_t ram_pool_capacity() const { return 0; }
 	};
 }
 
@@ -236,3 +236,23 @@ bool Platform_env_base::Rm_session_mmap::_dataspace_writable(Dataspace_capabilit
 
 	return ds ? ds->writable() : false;
 }
+
+
+bool Platform_env_base::Rm_session_mmap::_dataspace_huge_pages(Dataspace_capability ds_cap)
+{
+	if (!core_env()->entrypoint()->is_myself()) {
+		/* release Rm_session_mmap::_lock during RPC */
+		_lock.unlock();
+		bool huge_pages = Linux_dataspace_client(ds_cap).huge_pages();
+		_lock.lock();
+		return huge_pages;
+	}
+
+	Capability<Linux_dataspace> lx_ds_cap = static_cap_cast<Linux_dataspace>(ds_cap);
+
+	Object_pool<Rpc_object_base>::Guard
+		ds_rpc(core_env()->entrypoint()->lookup_and_lock(lx_ds_cap));
+	Linux_dataspace * ds = dynamic_cast<Linux_dataspace *>(&*ds_rpc);
+
+	return ds ? ds->huge_pages() : false;
+}
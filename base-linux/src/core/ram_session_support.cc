@@ -2,6 +2,18 @@
  * \brief  Make dataspace accessible to other Linux processes
  * \author Norman Feske
  * \date   2006-07-03
+ *
+ * RAM dataspaces are backed by anonymous memory files (memfd). Each file is
+ * sealed against resizing so that a process holding the file descriptor
+ * cannot shrink the dataspace under the feet of other processes. If the
+ * kernel lacks support for memory files, the dataspace is backed by an
+ * unlinked file in the resource path instead.
+ *
+ * To keep the allocation latency low, core maintains a pool of pre-created
+ * memory files for common dataspace sizes. The pool is replenished by a
+ * dedicated thread. The number of files kept per size adapts to the
+ * allocation rate: it is doubled whenever an allocation misses the pool
+ * and slowly decays while the pool is sufficient.
  */
 
 /*
@@ -16,6 +28,8 @@
 
 /* Genode includes */
 #include <base/snprintf.h>
+#include <base/thread.h>
+#include <base/semaphore.h>
 
 /* local includes */
 #include <ram_session_component.h>
@@ -28,20 +42,225 @@
 using namespace Genode;
 
 
-static int ram_ds_cnt = 0;  /* counter for creating unique dataspace IDs */
+/**
+ * Create sealed memory file of the given size
+ *
+ * \return file descriptor, or negative error code
+ */
+static int create_memfd(size_t size)
+{
+	int const fd = lx_memfd_create("genode-ram", LX_MFD_CLOEXEC | LX_MFD_ALLOW_SEALING);
+	if (fd < 0)
+		return fd;
 
-void Ram_session_component::_export_ram_ds(Dataspace_component *ds)
+	int const ret = lx_ftruncate(fd, size);
+	if (ret < 0) {
+		lx_close(fd);
+		return ret;
+	}
+
+	/* sealing is optional, dataspaces stay usable if it is not supported */
+	lx_fcntl(fd, LX_F_ADD_SEALS, LX_F_SEAL_SHRINK | LX_F_SEAL_GROW | LX_F_SEAL_SEAL);
+	return fd;
+}
+
+
+/**
+ * Pool of pre-created memory files for common dataspace sizes
+ */
+class Memfd_pool : Thread<4096*sizeof(long)>
 {
+	public:
+
+		enum {
+			MIN_SIZE_LOG2 = 12,
+			MAX_SIZE_LOG2 = 20,
+			NUM_CLASSES   = MAX_SIZE_LOG2 - MIN_SIZE_LOG2 + 1,
+			MIN_TARGET    = 2,   /* files kept per class at least */
+			MAX_TARGET    = 32,  /* files kept per class at most  */
+		};
+
+	private:
+
+		struct Size_class
+		{
+			int      fds[MAX_TARGET];
+			unsigned count;   /* number of pre-created files */
+			unsigned target;  /* number of files to keep     */
+			bool     missed;  /* allocation missed the pool since last refill */
+
+			Size_class() : count(0), target(MIN_TARGET), missed(false) { }
+		};
+
+		Size_class _classes[NUM_CLASSES];
+		Lock       _lock;
+		Semaphore  _refill_sem;
+		bool       _refill_pending;
+
+		/**
+		 * Return size class of dataspace size, or -1 if not pooled
+		 */
+		static int _size_class(size_t size)
+		{
+			for (int i = 0; i < NUM_CLASSES; i++)
+				if (size == (1UL << (MIN_SIZE_LOG2 + i)))
+					return i;
+
+			return -1;
+		}
+
+		/**
+		 * Wake up refill thread, must be called with '_lock' held
+		 */
+		void _request_refill()
+		{
+			if (_refill_pending)
+				return;
+
+			_refill_pending = true;
+			_refill_sem.up();
+		}
+
+		/**
+		 * Fill size class up to its target
+		 */
+		void _refill(int i)
+		{
+			size_t const size = 1UL << (MIN_SIZE_LOG2 + i);
+			Size_class  &c    = _classes[i];
+
+			{
+				Lock::Guard guard(_lock);
+
+				/* let the target decay while the pool is sufficient */
+				if (!c.missed && c.count >= c.target/2 && c.target > MIN_TARGET)
+					c.target--;
+				c.missed = false;
+			}
+
+			for (;;) {
+				{
+					Lock::Guard guard(_lock);
+					if (c.count >= c.target)
+						return;
+				}
+
+				/* create file without holding the lock */
+				int const fd = create_memfd(size);
+				if (fd < 0)
+					return;
+
+				Lock::Guard guard(_lock);
+				if (c.count < MAX_TARGET)
+					c.fds[c.count++] = fd;
+				else
+					lx_close(fd);
+			}
+		}
+
+		void entry()
+		{
+			for (;;) {
+				_refill_sem.down();
+
+				{
+					Lock::Guard guard(_lock);
+					_refill_pending = false;
+				}
+
+				for (int i = 0; i < NUM_CLASSES; i++)
+					_refill(i);
+			}
+		}
+
+	public:
+
+		Memfd_pool() : Thread<4096*sizeof(long)>("memfd_pool"), _refill_pending(false)
+		{
+			start();
+
+			Lock::Guard guard(_lock);
+			_request_refill();
+		}
+
+		/**
+		 * Obtain memory file of the given size
+		 *
+		 * \return file descriptor, or negative error code
+		 */
+		int alloc(size_t size)
+		{
+			int const i = _size_class(size);
+			if (i >= 0) {
+				Lock::Guard guard(_lock);
+
+				Size_class &c = _classes[i];
+
+				if (c.count) {
+					int const fd = c.fds[--c.count];
+					if (c.count < c.target/2)
+						_request_refill();
+					return fd;
+				}
+
+				/* adapt to the allocation rate */
+				c.missed = true;
+				c.target = min(2*c.target, (unsigned)MAX_TARGET);
+				_request_refill();
+			}
+
+			return create_memfd(size);
+		}
+};
+
+
+/**
+ * Return true if the kernel supports memory files
+ */
+static bool memfd_supported()
+{
+	struct Probe
+	{
+		bool supported;
+
+		Probe() : supported(false)
+		{
+			int const fd = lx_memfd_create("genode-probe", LX_MFD_CLOEXEC);
+			if (fd >= 0) {
+				lx_close(fd);
+				supported = true;
+			}
+		}
+	};
+
+	static Probe probe;
+	return probe.supported;
+}
+
+
+static Memfd_pool *memfd_pool()
+{
+	static Memfd_pool pool;
+	return &pool;
+}
+
+
+/**
+ * Create unlinked file in the resource path
+ *
+ * This is the fallback for kernels without support for memory files.
+ */
+static int create_resource_file(size_t size)
+{
+	static int ram_ds_cnt = 0;  /* counter for creating unique dataspace IDs */
+
 	char fname[Linux_dataspace::FNAME_LEN];
 
 	/* create file using a unique file name in the resource path */
 	snprintf(fname, sizeof(fname), "%s/ds-%d", resource_path(), ram_ds_cnt++);
 	lx_unlink(fname);
 	int const fd = lx_open(fname, O_CREAT|O_RDWR|O_TRUNC|LX_O_CLOEXEC, S_IRWXU);
-	lx_ftruncate(fd, ds->size());
-
-	/* remember file descriptor in dataspace component object */
-	ds->fd(fd);
+	lx_ftruncate(fd, size);
 
 	/*
 	 * Wipe the file from the Linux file system. The kernel will still keep the
@@ -50,6 +269,25 @@ void Ram_session_component::_export_ram_ds(Dataspace_component *ds)
 	 * w/o the right file descriptor won't be able to open and access the file.
 	 */
 	lx_unlink(fname);
+	return fd;
+}
+
+
+void Ram_session_component::_export_ram_ds(Dataspace_component *ds)
+{
+	int fd = -1;
+
+	if (memfd_supported())
+		fd = memfd_pool()->alloc(ds->size());
+
+	if (fd < 0)
+		fd = create_resource_file(ds->size());
+
+	/* remember file descriptor in dataspace component object */
+	ds->fd(fd);
+
+	/* apply huge-page policy of the RAM session */
+	ds->huge_pages(_huge_pages_min && ds->size() >= _huge_pages_min);
 }
 
 
@@ -62,3 +300,98 @@ void Ram_session_component::_revoke_ram_ds(Dataspace_component *ds)
 
 
 void Ram_session_component::_clear_ds(Dataspace_component *ds) { }
+
+
+/**
+ * Copy range of a file by mapping both files core-locally
+ *
+ * The offset need not be page-aligned, e.g., after a partial
+ * 'copy_file_range'. The mappings start at the page containing 'offset'.
+ */
+static bool copy_range_mapped(int src_fd, int dst_fd, addr_t offset, size_t size)
+{
+	enum { LX_PROT_READ = 0x1, LX_PROT_WRITE = 0x2, LX_MAP_SHARED = 0x1 };
+	enum { PAGE_MASK = 4096 - 1 };
+
+	addr_t const map_offset = offset & ~(addr_t)PAGE_MASK;
+	addr_t const skip       = offset - map_offset;
+	size_t const map_size   = size + skip;
+
+	void * const src = lx_mmap(0, map_size, LX_PROT_READ, LX_MAP_SHARED,
+	                           src_fd, map_offset);
+	if (((long)src < 0) && ((long)src > -4095))
+		return false;
+
+	void * const dst = lx_mmap(0, map_size, LX_PROT_READ | LX_PROT_WRITE,
+	                           LX_MAP_SHARED, dst_fd, map_offset);
+	if (((long)dst < 0) && ((long)dst > -4095)) {
+		lx_munmap(src, map_size);
+		return false;
+	}
+
+	memcpy((char *)dst + skip, (char const *)src + skip, size);
+
+	lx_munmap(src, map_size);
+	lx_munmap(dst, map_size);
+	return true;
+}
+
+
+/**
+ * Copy range of a file
+ */
+static bool copy_range(int src_fd, int dst_fd, addr_t offset, size_t size)
+{
+	long long src_off = offset, dst_off = offset;
+
+	while (size) {
+		long const ret = lx_copy_file_range(src_fd, &src_off, dst_fd, &dst_off, size);
+		if (ret <= 0)
+			return copy_range_mapped(src_fd, dst_fd, (addr_t)src_off, size);
+
+		size -= ret;
+	}
+	return true;
+}
+
+
+/*
+ * Memory files are sparse. Pages that were never touched are holes, which
+ * read as zeros. Because the destination is a fresh memory file, we copy
+ * the populated ranges of the source only. Hence, the costs of the copy
+ * depend on the memory actually used rather than on the dataspace size.
+ */
+bool Ram_session_component::_copy_ds(Dataspace_component *src,
+                                     Dataspace_component *dst)
+{
+	int    const src_fd = src->fd().dst().socket;
+	int    const dst_fd = dst->fd().dst().socket;
+	size_t const size   = src->size();
+
+	if (src_fd < 0 || dst_fd < 0)
+		return false;
+
+	for (addr_t offset = 0; offset < size; ) {
+
+		long const data = lx_lseek(src_fd, offset, LX_SEEK_DATA);
+
+		/* no data beyond offset */
+		enum { LX_ENXIO = 6 };
+		if (data == -LX_ENXIO)
+			break;
+
+		/* file system does not report holes, copy remaining range */
+		if (data < 0)
+			return copy_range(src_fd, dst_fd, offset, size - offset);
+
+		long hole = lx_lseek(src_fd, data, LX_SEEK_HOLE);
+		if (hole < 0 || (addr_t)hole > size)
+			hole = size;
+
+		if (!copy_range(src_fd, dst_fd, data, hole - data))
+			return false;
+
+		offset = hole;
+	}
+	return true;
+}
@@ -9,6 +9,7 @@ SRC_CC        = main.cc \
                 platform_thread.cc \
                 platform_services.cc \
                 ram_session_component.cc \
+                zeroed_ram_pool.cc \
                 ram_session_support.cc \
                 rom_session_component.cc \
                 cpu_session_component.cc \
@@ -44,6 +45,7 @@ endif
 
 vpath main.cc                     $(GEN_CORE_DIR)
 vpath ram_session_component.cc    $(GEN_CORE_DIR)
+vpath zeroed_ram_pool.cc          $(GEN_CORE_DIR)
 vpath cpu_session_component.cc    $(GEN_CORE_DIR)
 vpath platform_services.cc        $(GEN_CORE_DIR)
 vpath signal_session_component.cc $(GEN_CORE_DIR)
@@ -38,6 +38,7 @@
 #include <signal.h>
 #include <sched.h>
 #include <sys/syscall.h>
+#include <sys/stat.h>
 
 /* Genode includes */
 #include <util/string.h>
@@ -86,12 +87,66 @@ inline int lx_close(int fd)
 }
 
 
+inline int lx_dup(int fd)
+{
+	return lx_syscall(SYS_dup, fd);
+}
+
+
 inline int lx_dup2(int fd, int to)
 {
 	return lx_syscall(SYS_dup2, fd, to);
 }
 
 
+inline int lx_fcntl(int fd, int cmd, long arg)
+{
+	return lx_syscall(SYS_fcntl, fd, cmd, arg);
+}
+
+
+inline int lx_ftruncate(int fd, unsigned long length)
+{
+	return lx_syscall(SYS_ftruncate, fd, length);
+}
+
+
+inline int lx_fstat(int fd, struct stat64 *buf)
+{
+#ifdef _LP64
+	return lx_syscall(SYS_fstat, fd, buf);
+#else
+	return lx_syscall(SYS_fstat64, fd, buf);
+#endif
+}
+
+
+enum { LX_MFD_CLOEXEC = 0x1U, LX_MFD_ALLOW_SEALING = 0x2U };
+
+enum {
+	LX_F_ADD_SEALS    = 1033,
+	LX_F_SEAL_SEAL    = 0x1,
+	LX_F_SEAL_SHRINK  = 0x2,
+	LX_F_SEAL_GROW    = 0x4,
+};
+
+/**
+ * Create anonymous memory file
+ *
+ * \return  file descriptor, or negative error code (e.g., if the kernel
+ *          does not support memory file descriptors)
+ */
+inline int lx_memfd_create(char const *name, unsigned flags)
+{
+#ifdef SYS_memfd_create
+	return lx_syscall(SYS_memfd_create, name, flags);
+#else
+	enum { LX_ENOSYS = 38 };
+	return -LX_ENOSYS;
+#endif
+}
+
+
 /*****************************************
  ** Functions used by the IPC framework **
  *****************************************/
@@ -163,6 +218,19 @@ inline int lx_getpeername(int sockfd, struct sockaddr *name, socklen_t *namelen)
 #endif /* SYS_socketcall */
 
 
+struct pollfd;
+
+/**
+ * Wait for events on file descriptors
+ *
+ * \param timeout_ms  timeout in milliseconds, or -1 for blocking infinitely
+ */
+inline int lx_poll(struct pollfd *fds, unsigned long nfds, int timeout_ms)
+{
+	return lx_syscall(SYS_poll, fds, nfds, timeout_ms);
+}
+
+
 /*******************************************
  ** Functions used by the process library **
  *******************************************/
@@ -233,6 +301,14 @@ inline Genode::addr_t lx_vm_reserve(Genode::addr_t base, Genode::size_t size)
 }
 
 
+enum { LX_MADV_HUGEPAGE = 14, LX_MADV_POPULATE_READ = 22, LX_MADV_POPULATE_WRITE = 23 };
+
+inline int lx_madvise(void *addr, Genode::size_t length, int advice)
+{
+	return lx_syscall(SYS_madvise, addr, length, advice);
+}
+
+
 /***********************************************************************
  ** Functions used by thread lib and core's cancel-blocking mechanism **
  ***********************************************************************/
@@ -340,8 +416,10 @@ inline int lx_nanosleep(const struct timespec *req, struct timespec *rem)
 }
 
 enum {
-	LX_FUTEX_WAIT = FUTEX_WAIT,
-	LX_FUTEX_WAKE = FUTEX_WAKE,
+	LX_FUTEX_WAIT         = FUTEX_WAIT,
+	LX_FUTEX_WAKE         = FUTEX_WAKE,
+	LX_FUTEX_WAIT_PRIVATE = FUTEX_WAIT | FUTEX_PRIVATE_FLAG,
+	LX_FUTEX_WAKE_PRIVATE = FUTEX_WAKE | FUTEX_PRIVATE_FLAG,
 };
 
 inline int lx_futex(const int *uaddr, int op, int val)
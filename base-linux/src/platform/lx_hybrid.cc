@@ -97,6 +97,7 @@ int    genode_argc = 1;
 /* Genode includes */
 #include <base/thread.h>
 #include <base/env.h>
+#include <base/heap.h>
 
 /* libc includes */
 #include <pthread.h>
@@ -106,6 +107,15 @@ int    genode_argc = 1;
 using namespace Genode;
 
 
+namespace Genode {
+
+	/*
+	 * Helper to release the reply channel of a thread, defined in 'ipc.cc'
+	 */
+	void destroy_reply_channel(Native_reply_channel &rc);
+}
+
+
 /**
  * Return TLS key used to storing the thread meta data
  */
@@ -403,7 +413,8 @@ void Thread_base::join()
 
 Thread_base::Thread_base(const char *name, size_t stack_size)
 :
-	_list_element(this)
+	_list_element(this),
+	_trace_logger(name)
 {
 	_tid.meta_data = new (env()->heap()) Thread_meta_data_created(this);
 
@@ -453,6 +464,12 @@ Thread_base::~Thread_base()
 	destroy(env()->heap(), _tid.meta_data);
 	_tid.meta_data = 0;
 
+	/* release the reply channel used by the thread's RPC calls */
+	destroy_reply_channel(_tid.reply_channel);
+
 	/* inform core about the killed thread */
 	cpu_session()->kill_thread(_thread_cap);
+
+	/* return memory cached for the thread by thread-cached heaps */
+	Thread_cached_heap::release_thread_caches(this);
 }
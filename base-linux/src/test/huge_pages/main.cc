@@ -0,0 +1,84 @@
+/*
+ * \brief  Benchmark for huge-page backed RAM dataspaces
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark touches a large RAM dataspace at random locations, which
+ * stresses the TLB. It is executed twice, for a dataspace allocated from a
+ * RAM session without huge-page policy and for a dataspace allocated from
+ * a RAM session that requests huge pages. If the host kernel does not
+ * support transparent huge pages for shared memory, both runs use normal
+ * pages and should perform alike.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <ram_session/connection.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+
+enum {
+	BUF_SIZE   = 128*1024*1024,
+	ACCESSES   = 10*1000*1000,
+	HUGE_PAGES = 2*1024*1024,
+};
+
+
+static void measure(char const *name, Ram_session &ram)
+{
+	Ram_dataspace_capability ds = ram.alloc(BUF_SIZE);
+	unsigned long *buf = env()->rm_session()->attach(ds);
+
+	/* populate dataspace */
+	enum { WORDS = BUF_SIZE/sizeof(unsigned long) };
+	for (unsigned long i = 0; i < WORDS; i += 4096/sizeof(unsigned long))
+		buf[i] = i;
+
+	unsigned      seed = 1;
+	unsigned long sum  = 0;
+
+	Trace::Timestamp const start = Trace::timestamp();
+
+	for (unsigned i = 0; i < ACCESSES; i++) {
+		seed = seed*1103515245 + 12345;
+		unsigned long &word = buf[(seed >> 4) % WORDS];
+		sum  += word;
+		word  = sum;
+	}
+
+	Trace::Timestamp const cycles = Trace::timestamp() - start;
+
+	printf("%s pages: %lu cycles per random access (checksum %lx)\n",
+	       name, (unsigned long)(cycles/ACCESSES), sum);
+
+	env()->rm_session()->detach(buf);
+	ram.free(ds);
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- huge-page benchmark ---\n");
+
+	measure("normal", *env()->ram_session());
+
+	/* RAM session that backs all dataspaces of at least 2 MiB by huge pages */
+	static Ram_connection huge_ram("huge", HUGE_PAGES);
+	huge_ram.ref_account(env()->ram_session_cap());
+	env()->ram_session()->transfer_quota(huge_ram.cap(), BUF_SIZE + 64*1024);
+
+	measure("huge", huge_ram);
+
+	printf("--- huge-page benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-huge_pages
+LIBS   = base
+SRC_CC = main.cc
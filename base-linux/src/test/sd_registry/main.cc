@@ -0,0 +1,85 @@
+/*
+ * \brief  Benchmark for the socket-descriptor registry
+ * \author agent
+ * \date   2026-10-17
+ *
+ * When receiving a capability, the IPC library looks up the global ID of
+ * the received socket in the socket-descriptor registry. The benchmark
+ * measures the cost of this lookup for registries populated with 10, 1000,
+ * and 10000 entrypoint sockets. The cost should not depend on the number
+ * of registered sockets.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <trace/timestamp.h>
+
+/* base-linux includes */
+#include <socket_descriptor_registry.h>
+
+using namespace Genode;
+
+
+/*
+ * The registry stores numbers only. So we can use made-up socket
+ * descriptors and global IDs.
+ */
+enum { FIRST_SD = 16, FIRST_ID = 1000, LOOKUPS = 1000000 };
+
+
+static void measure(unsigned num_sockets)
+{
+	typedef Socket_descriptor_registry<256> Registry;
+
+	Registry *registry = new (env()->heap()) Registry;
+
+	for (unsigned i = 0; i < num_sockets; i++)
+		registry->try_associate(FIRST_SD + i, FIRST_ID + i);
+
+	Trace::Timestamp const start = Trace::timestamp();
+
+	unsigned long r = 0;
+	for (unsigned i = 0; i < LOOKUPS; i++) {
+
+		/* linear congruential generator to visit the entries in random order */
+		r = r*1103515245 + 12345;
+		unsigned const index = r % num_sockets;
+
+		/* the socket of the already registered entrypoint is returned */
+		int const sd = registry->try_associate(FIRST_SD + num_sockets + 1,
+		                                       FIRST_ID + index);
+		if (sd != (int)(FIRST_SD + index))
+			PERR("lookup of ID %u returned unexpected sd %d", FIRST_ID + index, sd);
+	}
+
+	Trace::Timestamp const cycles = Trace::timestamp() - start;
+
+	printf("%5u sockets: %lu cycles per capability lookup\n",
+	       num_sockets, (unsigned long)(cycles / LOOKUPS));
+
+	for (unsigned i = 0; i < num_sockets; i++)
+		registry->disassociate(FIRST_SD + i);
+
+	destroy(env()->heap(), registry);
+}
+
+
+int main(int, char **)
+{
+	printf("--- socket-descriptor registry benchmark started ---\n");
+
+	measure(10);
+	measure(1000);
+	measure(10000);
+
+	printf("--- socket-descriptor registry benchmark finished ---\n");
+	return 0;
+}
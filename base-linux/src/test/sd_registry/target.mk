@@ -0,0 +1,4 @@
+TARGET   = test-sd_registry
+SRC_CC   = main.cc
+LIBS     = base syscall
+INC_DIR += $(REP_DIR)/src/base/ipc
@@ -16,6 +16,7 @@
 /* Genode includes */
 #include <base/printf.h>
 #include <base/rpc_server.h>
+#include <trace/events.h>
 #include <base/env.h>
 #include <base/cap_sel_alloc.h>
 
@@ -47,7 +48,7 @@ Untyped_capability Rpc_entrypoint::_manage(Rpc_object_base *obj)
 
 	/* add server object to object pool */
 	obj->cap(ep_cap);
-	insert(obj);
+	_pool.insert(obj);
 
 	/* return entrypoint capability */
 	return ep_cap;
@@ -63,7 +64,7 @@ void Rpc_entrypoint::_dissolve(Rpc_object_base *obj)
 	Nova::revoke(Nova::Obj_crd(obj->cap().local_name(), 0), true);
 
 	/* make sure nobody is able to find this object */
-	remove_locked(obj);
+	_pool.remove_locked(obj);
 
 	/*
 	 * The activation may execute a blocking operation in a dispatch function.
@@ -114,7 +115,7 @@ void Rpc_entrypoint::_activation_entry()
 	srv.ret(ERR_INVALID_OBJECT);
 
 	/* atomically lookup and lock referenced object */
-	ep->_curr_obj = ep->lookup_and_lock(id_pt);
+	ep->_curr_obj = ep->_pool.lookup_and_lock(id_pt);
 	if (!ep->_curr_obj) {
 
 		/*
@@ -130,8 +131,10 @@ void Rpc_entrypoint::_activation_entry()
 	} else {
 
 		/* dispatch request */
+		Trace::event(Trace::RPC_DISPATCH, opcode, srv.badge());
 		try { srv.ret(ep->_curr_obj->dispatch(opcode, srv, srv)); }
 		catch (Blocking_canceled) { }
+		Trace::event(Trace::RPC_REPLY, opcode, srv.badge());
 
 		Rpc_object_base * tmp = ep->_curr_obj;
 		ep->_curr_obj = 0;
@@ -198,9 +201,11 @@ void Rpc_entrypoint::activate()
 
 
 Rpc_entrypoint::Rpc_entrypoint(Cap_session *cap_session, size_t stack_size,
-                               const char  *name, bool start_on_construction)
+                               const char  *name, bool start_on_construction,
+                               Object_pool<Rpc_object_base> *pool)
 :
 	Thread_base(name, stack_size),
+	_pool(pool ? *pool : *this),
 	_curr_obj(start_on_construction ? 0 : (Rpc_object_base *)~0UL),
 	_delay_start(Lock::LOCKED),
 	_cap_session(cap_session)
@@ -276,7 +281,8 @@ Rpc_entrypoint::~Rpc_entrypoint()
 {
 	typedef Object_pool<Rpc_object_base> Pool;
 
-	if (Pool::first()) {
+	/* objects of a shared pool are dissolved by the owner of the pool */
+	if (&_pool == this && Pool::first()) {
 		PWRN("Object pool not empty in %s", __func__);
 
 		/* dissolve all objects - objects are not destroyed! */
@@ -30,7 +30,8 @@ Rm_session::Local_addr
 Core_rm_session::attach(Dataspace_capability ds_cap, size_t size,
                         off_t offset, bool use_local_addr,
                         Rm_session::Local_addr local_addr,
-                        bool executable)
+                        bool executable,
+                        bool populate)
 {
 	Object_pool<Dataspace_component>::Guard ds(_ds_ep->lookup_and_lock(ds_cap));
 	if (!ds)
@@ -35,7 +35,8 @@ namespace Genode {
 			Local_addr attach(Dataspace_capability ds_cap, size_t size=0,
 			                  off_t offset=0, bool use_local_addr = false,
 			                  Local_addr local_addr = 0,
-			                  bool executable = false);
+			                  bool executable = false,
+			                  bool populate = false);
 
 			void detach(Local_addr)
 			{
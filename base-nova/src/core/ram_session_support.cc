@@ -102,3 +102,16 @@ void Ram_session_component::_clear_ds(Dataspace_component *ds)
 
 	ds->assign_core_local_addr(virt_addr);
 }
+
+
+bool Ram_session_component::_copy_ds(Dataspace_component *src,
+                                     Dataspace_component *dst)
+{
+	/* RAM dataspaces stay mapped core-locally after being cleared */
+	if (!src->core_local_addr() || !dst->core_local_addr())
+		return false;
+
+	memcpy((void *)dst->core_local_addr(), (void *)src->core_local_addr(),
+	       src->size());
+	return true;
+}
@@ -28,3 +28,6 @@ void Rm_client::unmap(addr_t core_local_base, addr_t, size_t size)
 	            (round_page(core_local_base + size) -
 	            trunc_page(core_local_base)) / get_page_size(), false);
 }
+
+
+void Rm_client::map(addr_t, addr_t, size_t, bool) { }
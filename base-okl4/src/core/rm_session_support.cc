@@ -27,3 +27,6 @@ void Rm_client::unmap(addr_t, addr_t virt_base, size_t size)
 	if (locked_address_space.is_valid())
 		locked_address_space->flush(virt_base, size);
 }
+
+
+void Rm_client::map(addr_t, addr_t, size_t, bool) { }
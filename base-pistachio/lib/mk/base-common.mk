@@ -12,7 +12,9 @@ SRC_CC += pager/pager.cc
 SRC_CC += avl_tree/avl_tree.cc
 SRC_CC += allocator/slab.cc
 SRC_CC += allocator/allocator_avl.cc
-SRC_CC += heap/heap.cc heap/sliced_heap.cc
+SRC_CC += allocator/allocator_stats.cc
+SRC_CC += trace/trace.cc
+SRC_CC += heap/heap.cc heap/sliced_heap.cc heap/thread_cached_heap.cc
 SRC_CC += console/console.cc
 SRC_CC += child/child.cc
 SRC_CC += process/process.cc
@@ -25,3 +25,11 @@ void Ram_session_component::_clear_ds(Dataspace_component *ds)
 {
 	memset((void *)ds->phys_addr(), 0, ds->size());
 }
+
+
+bool Ram_session_component::_copy_ds(Dataspace_component *src,
+                                     Dataspace_component *dst)
+{
+	memcpy((void *)dst->phys_addr(), (void *)src->phys_addr(), src->size());
+	return true;
+}
@@ -48,3 +48,6 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 		L4_Unmap(L4_FpageAddRightsTo(&fp, L4_FullyAccessible));
 	}
 }
+
+
+void Rm_client::map(addr_t, addr_t, size_t, bool) { }
@@ -0,0 +1,36 @@
+/*
+ * \brief  Trace timestamp
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__ARM__TRACE__TIMESTAMP_H_
+#define _INCLUDE__ARM__TRACE__TIMESTAMP_H_
+
+#include <base/stdint.h>
+
+namespace Genode {
+
+	namespace Trace {
+
+		typedef uint32_t Timestamp;
+
+		/**
+		 * Return time stamp
+		 *
+		 * None of the supported kernels enables user-level access to the
+		 * cycle counter of the performance monitor unit. Until then, time
+		 * stamps are not available on ARM.
+		 */
+		inline Timestamp timestamp() { return 0; }
+	}
+}
+
+#endif /* _INCLUDE__ARM__TRACE__TIMESTAMP_H_ */
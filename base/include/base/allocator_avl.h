@@ -36,6 +36,55 @@ namespace Genode {
 
 			class Block : public Avl_node<Block>
 			{
+				public:
+
+					/**
+					 * Node in the tree of free blocks
+					 *
+					 * The tree is ordered by the block size and, for blocks
+					 * of equal size, by the block address.
+					 */
+					class Size_node : public Avl_node<Size_node>
+					{
+						private:
+
+							Block *_block;
+
+						public:
+
+							Size_node(Block *block) : _block(block) { }
+
+							/**
+							 * Avl_node interface: compare two nodes
+							 */
+							bool higher(Size_node *n)
+							{
+								Block *a = n->_block;
+								return (a->size() == _block->size())
+								       ? a->addr() >= _block->addr()
+								       : a->size() >  _block->size();
+							}
+
+							/**
+							 * Find smallest block of subtree that can hold
+							 * 'size' bytes at the specified alignment
+							 *
+							 * \param min_size  blocks smaller than 'min_size'
+							 *                  are not considered
+							 * \param budget    maximum number of candidates
+							 *                  to check, decremented for
+							 *                  each checked candidate
+							 *
+							 * The search descends to the smallest block of
+							 * at least 'min_size' bytes and walks the
+							 * following blocks in order until one fits or
+							 * the budget is exhausted.
+							 */
+							Block *find_best_fit(size_t min_size, size_t size,
+							                     unsigned align,
+							                     unsigned long &budget);
+					};
+
 				private:
 
 					addr_t _addr;       /* base address    */
@@ -44,24 +93,14 @@ namespace Genode {
 					short  _id;         /* for debugging   */
 					size_t _max_avail;  /* biggest free block size of subtree */
 
+					Size_node _size_node;  /* node in tree of free blocks */
+
 					/**
 					 * Request max_avail value of subtree
 					 */
 					inline size_t _child_max_avail(bool side) {
 						return child(side) ? child(side)->max_avail() : 0; }
 
-					/**
-					 * Query if block can hold a specified subblock
-					 *
-					 * \param n       number of bytes
-					 * \param align   alignment (power of two)
-					 * \return        true if block fits
-					 */
-					inline bool _fits(size_t n, unsigned align = 1) {
-						return ((align_addr(addr(), align) >= addr()) &&
-						        _sum_in_range(align_addr(addr(), align), n) &&
-						        (align_addr(addr(), align) - addr() + n <= avail())); }
-
 				public:
 
 					/**
@@ -84,34 +123,42 @@ namespace Genode {
 					inline size_t size()          { return _size; }
 					inline bool   used()          { return _used; }
 					inline size_t max_avail()     { return _max_avail; }
-					inline void   used(bool used) { _used = used; }
+					inline Size_node *size_node() { return &_size_node; }
 
 					enum { FREE = false, USED = true };
 
+					/**
+					 * Query if block can hold a specified subblock
+					 *
+					 * \param n       number of bytes
+					 * \param align   alignment (power of two)
+					 * \return        true if block fits
+					 */
+					inline bool fits(size_t n, unsigned align = 1) {
+						return ((align_addr(addr(), align) >= addr()) &&
+						        _sum_in_range(align_addr(addr(), align), n) &&
+						        (align_addr(addr(), align) - addr() + n <= avail())); }
+
 					/**
 					 * Constructor
 					 *
 					 * This constructor is called from meta-data allocator during
 					 * initialization of new meta-data blocks.
 					 */
-					Block() : _addr(0), _size(0), _used(0), _max_avail(0) { }
+					Block()
+					: _addr(0), _size(0), _used(0), _max_avail(0), _size_node(this) { }
 
 					/**
 					 * Constructor
 					 */
 					Block(addr_t addr, size_t size, bool used)
 					: _addr(addr), _size(size), _used(used),
-					  _max_avail(used ? 0 : size)
+					  _max_avail(used ? 0 : size), _size_node(this)
 					{
 						static int num_blocks;
 						_id = ++num_blocks;
 					}
 
-					/**
-					 * Find best-fitting block
-					 */
-					Block *find_best_fit(size_t size, unsigned align = 1);
-
 					/**
 					 * Find block that contains the specified address range
 					 */
@@ -132,9 +179,11 @@ namespace Genode {
 
 		private:
 
-			Avl_tree<Block>  _addr_tree;      /* blocks sorted by base address */
-			Allocator       *_md_alloc;       /* meta-data allocator           */
-			size_t           _md_entry_size;  /* size of block meta-data entry */
+			Avl_tree<Block>            _addr_tree;  /* blocks sorted by base address */
+			Avl_tree<Block::Size_node> _size_tree;  /* free blocks sorted by size    */
+
+			Allocator *_md_alloc;       /* meta-data allocator           */
+			size_t     _md_entry_size;  /* size of block meta-data entry */
 
 			/**
 			 * Alloc meta-data block
@@ -152,6 +201,11 @@ namespace Genode {
 			int _add_block(Block *block_metadata,
 			               addr_t base, size_t size, bool used);
 
+			/**
+			 * Remove block from the trees without releasing its meta data
+			 */
+			void _remove_block(Block *b);
+
 			/**
 			 * Destroy block
 			 */
@@ -284,6 +338,15 @@ namespace Genode {
 				_metadata((metadata_chunk_alloc) ? metadata_chunk_alloc : this,
 				          (Slab_block *)&_initial_md_block) { }
 
+			/**
+			 * Return empty meta-data blocks to the meta-data allocator
+			 *
+			 * The meta-data blocks of an allocator that hosts its own meta
+			 * data are never returned.
+			 */
+			void release_empty_metadata_blocks(bool enabled) {
+				_metadata.release_empty_blocks(enabled && _metadata.backing_store() != this); }
+
 			/**
 			 * Assign custom meta data to block at specified address
 			 */
@@ -0,0 +1,202 @@
+/*
+ * \brief  Allocator wrapper that collects usage statistics
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__ALLOCATOR_STATS_H_
+#define _INCLUDE__BASE__ALLOCATOR_STATS_H_
+
+#include <base/allocator.h>
+#include <base/lock.h>
+#include <util/list.h>
+
+namespace Genode {
+
+	class Slab;
+
+	/**
+	 * Allocator that records statistics about the use of another allocator
+	 *
+	 * The wrapper counts allocations, frees, and failed allocations, tracks
+	 * the number of bytes in use and its high-water mark, and keeps a
+	 * histogram of block sizes. If a sampling interval is specified, every
+	 * n-th allocation is attributed to its call site, which allows for the
+	 * identification of the code responsible for the memory in use.
+	 *
+	 * Each block is preceded by a small header that holds its size and
+	 * sampled call site. Hence, the wrapper does not depend on the size
+	 * argument of 'free'.
+	 *
+	 * Because of the header, a request of 'size' bytes results in a block
+	 * of 'size + sizeof(Header)' bytes at the instrumented allocator. This
+	 * must be taken into account for allocators of fixed-size blocks such
+	 * as 'Slab', which ignore the requested size. When wrapping a slab, its
+	 * entries must be large enough to hold the header in addition to the
+	 * largest block requested via the wrapper. Requests that exceed this
+	 * limit are rejected and counted as failed allocations. The limit is
+	 * picked up automatically if the slab is passed to the constructor as
+	 * 'Slab', but not if it is passed as plain 'Allocator'.
+	 *
+	 * All instances are registered globally. The statistics of all instances
+	 * can be obtained as XML via 'generate_xml_all' or printed to the LOG
+	 * via 'print_all', e.g., from a signal handler or periodic timeout.
+	 */
+	class Allocator_stats : public Allocator, public List<Allocator_stats>::Element
+	{
+		public:
+
+			enum {
+				NUM_SIZE_BUCKETS = 24,  /* from 16 bytes to 64 MiB */
+				MAX_CALL_SITES   = 32,
+				NAME_LEN         = 32,
+			};
+
+		private:
+
+			/**
+			 * Meta data preceding each block
+			 */
+			struct Header
+			{
+				size_t size;
+				addr_t call_site;  /* 0 if allocation was not sampled */
+			};
+
+			struct Size_bucket
+			{
+				unsigned long allocs;  /* total number of allocations */
+				unsigned long live;    /* number of blocks in use */
+			};
+
+			struct Call_site
+			{
+				addr_t        ip;
+				unsigned long samples;  /* number of sampled allocations */
+				size_t        live;     /* sampled bytes in use */
+			};
+
+			Allocator    &_alloc;
+			size_t const  _max_block_size;  /* 0 if not limited */
+			char          _name[NAME_LEN];
+			unsigned      _sample_interval;
+			unsigned      _sample_countdown;
+			Lock mutable  _lock;
+
+			unsigned long _num_allocs;
+			unsigned long _num_frees;
+			unsigned long _num_failed;
+			unsigned long _num_unattributed;  /* samples not fitting the table */
+			size_t        _used;
+			size_t        _peak;
+
+			Size_bucket   _sizes[NUM_SIZE_BUCKETS];
+			Call_site     _sites[MAX_CALL_SITES];
+
+			/**
+			 * Return index of histogram bucket for the given block size
+			 */
+			static unsigned _size_bucket(size_t size);
+
+			/**
+			 * Return upper bound of block sizes counted in the bucket
+			 */
+			static size_t _bucket_limit(unsigned bucket) { return 16UL << bucket; }
+
+			/**
+			 * Lookup call site, create entry if not present
+			 *
+			 * \return call-site entry or 0 if the table is exhausted
+			 */
+			Call_site *_call_site(addr_t ip, bool create);
+
+			/**
+			 * Initialize statistics and register instance
+			 */
+			void _init(char const *name);
+
+		public:
+
+			/**
+			 * Constructor
+			 *
+			 * \param alloc            allocator to instrument
+			 * \param name             name used in the XML report
+			 * \param sample_interval  attribute every n-th allocation to its
+			 *                         call site, 0 disables the sampling
+			 */
+			Allocator_stats(Allocator &alloc, char const *name,
+			                unsigned sample_interval = 0);
+
+			/**
+			 * Constructor for instrumenting a slab allocator
+			 *
+			 * Requests that do not fit into a slab entry along with the
+			 * header are rejected.
+			 */
+			Allocator_stats(Slab &slab, char const *name,
+			                unsigned sample_interval = 0);
+
+			~Allocator_stats();
+
+			/**
+			 * Return number of bytes handed out and not yet freed
+			 */
+			size_t used() const;
+
+			/**
+			 * Return high-water mark of 'used'
+			 */
+			size_t peak() const;
+
+			/**
+			 * Reset high-water mark to the current use
+			 */
+			void reset_peak();
+
+			/**
+			 * Write statistics as XML into character buffer
+			 *
+			 * \return number of characters written, the output is truncated
+			 *         if the buffer is too small
+			 */
+			size_t generate_xml(char *dst, size_t dst_len) const;
+
+			/**
+			 * Write statistics of all instances as XML into character buffer
+			 *
+			 * \return number of characters written
+			 */
+			static size_t generate_xml_all(char *dst, size_t dst_len);
+
+			/**
+			 * Print statistics of all instances as XML to the LOG
+			 */
+			static void print_all();
+
+
+			/*************************
+			 ** Allocator interface **
+			 *************************/
+
+			bool alloc(size_t size, void **out_addr);
+
+			void free(void *addr, size_t size);
+
+			size_t consumed() { return _alloc.consumed(); }
+
+			size_t overhead(size_t size) {
+				return _alloc.overhead(size + sizeof(Header)) + sizeof(Header); }
+
+			bool need_size_for_free() const { return false; }
+	};
+}
+
+#endif /* _INCLUDE__BASE__ALLOCATOR_STATS_H_ */
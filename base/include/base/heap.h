@@ -15,6 +15,8 @@
 #define _INCLUDE__BASE__HEAP_H_
 
 #include <util/list.h>
+#include <util/avl_tree.h>
+#include <util/misc_math.h>
 #include <ram_session/ram_session.h>
 #include <rm_session/rm_session.h>
 #include <base/allocator_avl.h>
@@ -22,6 +24,8 @@
 
 namespace Genode {
 
+	class Thread_base;
+
 	/**
 	 * Heap that uses dataspaces as backing store
 	 *
@@ -37,19 +41,60 @@ namespace Genode {
 				MAX_CHUNK_SIZE = 256*1024
 			};
 
-			class Dataspace : public List<Dataspace>::Element
+			/**
+			 * Backing-store dataspace of the heap
+			 *
+			 * The meta data of each dataspace is located at the beginning of
+			 * the dataspace itself, outside of the range managed by the
+			 * allocator. So a dataspace can be released without touching
+			 * blocks of other dataspaces.
+			 */
+			class Dataspace : public List<Dataspace>::Element,
+			                  public Avl_node<Dataspace>
 			{
 				public:
 
 					Ram_dataspace_capability cap;
-					void  *local_addr;
+					void    *local_addr;
+					size_t   size;
+					unsigned num_blocks;  /* number of heap blocks within */
 
-					Dataspace(Ram_dataspace_capability c, void *a)
-					: cap(c), local_addr(a) {}
+					Dataspace(Ram_dataspace_capability c, void *a, size_t s)
+					: cap(c), local_addr(a), size(s), num_blocks(0) {}
 
 					inline void * operator new(Genode::size_t, void* addr) {
 						return addr; }
 					inline void operator delete(void*) { }
+
+					/**
+					 * Return address range available for heap blocks
+					 */
+					addr_t range_base() const {
+						return align_addr((addr_t)local_addr + sizeof(Dataspace), 4); }
+
+					size_t range_size() const {
+						return size - (range_base() - (addr_t)local_addr); }
+
+					bool contains(addr_t addr) const {
+						return addr >= (addr_t)local_addr
+						    && addr - (addr_t)local_addr < size; }
+
+					/**
+					 * Avl_node interface
+					 */
+					bool higher(Dataspace *ds) {
+						return ds->local_addr > local_addr; }
+
+					/**
+					 * Find dataspace containing the specified address
+					 */
+					Dataspace *find_by_addr(addr_t addr)
+					{
+						if (contains(addr)) return this;
+
+						Dataspace *ds = child(addr > (addr_t)local_addr);
+						return ds ? ds->find_by_addr(addr) : 0;
+					}
 			};
 
 			class Dataspace_pool : public List<Dataspace>
@@ -59,6 +104,8 @@ namespace Genode {
 					Ram_session *_ram_session;  /* ram session for backing store */
 					Rm_session  *_rm_session;   /* region manager                */
 
+					Avl_tree<Dataspace> _tree;  /* dataspaces by address */
+
 				public:
 
 					/**
@@ -76,17 +123,176 @@ namespace Genode {
 					 * Expand dataspace by specified size
 					 *
 					 * \param size      number of bytes to add to the dataspace pool
-					 * \param md_alloc  allocator to expand. This allocator is also
-					 *                  used for meta data allocation (only after
-					 *                  being successfully expanded).
+					 * \param alloc     allocator to expand
 					 * \throw           Rm_session::Invalid_dataspace,
 					 *                  Rm_session::Region_conflict
 					 * \return          0 on success or negative error code
 					 */
 					int expand(size_t size, Range_allocator *alloc);
 
+					/**
+					 * Release dataspace to the RAM session
+					 *
+					 * \return  false if the address range of the dataspace
+					 *          could not be removed from the allocator
+					 */
+					bool release(Dataspace *ds, Range_allocator *alloc);
+
+					/**
+					 * Return dataspace containing the specified address
+					 *
+					 * \return  dataspace, or 0 if the address does not belong
+					 *          to any dataspace of the pool
+					 */
+					Dataspace *lookup(addr_t addr)
+					{
+						Dataspace *ds = _tree.first();
+						return ds ? ds->find_by_addr(addr) : 0;
+					}
+
+					void reassign_resources(Ram_session *ram, Rm_session *rm) {
+						_ram_session = ram, _rm_session = rm; }
+			};
+
+			/**
+			 * Allocator for the meta data of the local allocator
+			 *
+			 * The meta data is kept apart from the dataspaces that hold heap
+			 * blocks. Otherwise, meta data scattered over all dataspaces
+			 * would prevent the release of unused dataspaces. The allocator
+			 * hands out slots of 'SLOT_SIZE', which corresponds to the size
+			 * of the meta-data blocks requested by 'Allocator_avl'. Slots
+			 * are taken from chunks, which are dataspaces growing from
+			 * 'MIN_CHUNK_SIZE' up to 'MAX_CHUNK_SIZE'. The chunks count
+			 * against the quota limit of the heap.
+			 *
+			 * Releasing a dataspace of the heap removes its range from the
+			 * local allocator, which may need a slot. For each dataspace,
+			 * the heap reserves one slot in advance. So the release never
+			 * allocates a chunk. Empty chunks are not released while the
+			 * local allocator is in the middle of an operation but by an
+			 * explicit call of 'release_empty_chunks'.
+			 */
+			class Md_alloc : public Allocator
+			{
+				public:
+
+					enum {
+						SLOT_SIZE      = 256*sizeof(addr_t),
+						MIN_CHUNK_SIZE = 8*SLOT_SIZE,
+						MAX_CHUNK_SIZE = 64*1024
+					};
+
+				private:
+
+					struct Slot { Slot *next; };
+
+					/**
+					 * Chunk of slots
+					 *
+					 * All chunks are indexed by address. Chunks with free
+					 * slots are additionally kept in a list.
+					 */
+					struct Chunk : List<Chunk>::Element, Avl_node<Chunk>
+					{
+						Ram_dataspace_capability cap;
+						size_t   size;
+						Slot    *free;
+						unsigned num_slots;
+						unsigned num_used;
+
+						Chunk(Ram_dataspace_capability cap, size_t size)
+						: cap(cap), size(size), free(0), num_slots(0), num_used(0) { }
+
+						inline void * operator new(Genode::size_t, void* addr) {
+							return addr; }
+						inline void operator delete(void*) { }
+
+						bool contains(addr_t addr) const {
+							return addr >= (addr_t)this
+							    && addr - (addr_t)this < size; }
+
+						/**
+						 * Avl_node interface
+						 */
+						bool higher(Chunk *c) { return c > this; }
+
+						/**
+						 * Find chunk containing the specified address
+						 */
+						Chunk *find_by_addr(addr_t addr)
+						{
+							if (contains(addr)) return this;
+
+							Chunk *c = child(addr > (addr_t)this);
+							return c ? c->find_by_addr(addr) : 0;
+						}
+					};
+
+					Ram_session    *_ram_session;
+					Rm_session     *_rm_session;
+					size_t const   &_quota_limit;   /* quota limit of the heap    */
+					size_t const   &_quota_used;    /* quota used by heap blocks  */
+					Avl_tree<Chunk> _chunks;
+					List<Chunk>     _avail;         /* chunks with free slots     */
+					unsigned        _num_empty;     /* chunks without used slots  */
+					unsigned        _num_free;      /* free slots of all chunks   */
+					unsigned        _num_reserved;  /* slots kept free            */
+					size_t          _chunk_size;    /* size of next chunk         */
+					size_t          _consumed;      /* size of all chunks         */
+
+					Chunk *_new_chunk();
+					void   _release(Chunk *chunk);
+
+				public:
+
+					Md_alloc(Ram_session *ram_session, Rm_session *rm_session,
+					         size_t const &quota_limit, size_t const &quota_used)
+					:
+						_ram_session(ram_session), _rm_session(rm_session),
+						_quota_limit(quota_limit), _quota_used(quota_used),
+						_num_empty(0), _num_free(0), _num_reserved(0),
+						_chunk_size(MIN_CHUNK_SIZE), _consumed(0)
+					{ }
+
+					~Md_alloc();
+
 					void reassign_resources(Ram_session *ram, Rm_session *rm) {
 						_ram_session = ram, _rm_session = rm; }
+
+					/**
+					 * Allocate chunks until the reserved slots are free
+					 *
+					 * \return  false if a chunk could not be allocated
+					 */
+					bool replenish();
+
+					/**
+					 * Reserve slot and make sure that it is free
+					 *
+					 * \return  false if the slot could not be provided, in
+					 *          which case nothing is reserved
+					 */
+					bool reserve();
+
+					/**
+					 * Drop reservation of a slot
+					 */
+					void unreserve() { _num_reserved--; }
+
+					/**
+					 * Release empty chunks not needed for reserved slots
+					 *
+					 * One empty chunk is kept to avoid allocating chunks
+					 * repeatedly.
+					 */
+					void release_empty_chunks();
+
+					bool alloc(size_t size, void **out_addr);
+					void free(void *addr, size_t);
+					size_t consumed() { return _consumed; }
+					size_t overhead(size_t) { return 0; }
+					bool need_size_for_free() const { return false; }
 			};
 
 			/*
@@ -95,11 +301,14 @@ namespace Genode {
 			 */
 
 			Lock           _lock;
-			Dataspace_pool _ds_pool;      /* list of dataspaces */
+			Md_alloc       _md_alloc;     /* meta-data allocator */
+			Dataspace_pool _ds_pool;      /* list of dataspaces  */
 			Allocator_avl  _alloc;        /* local allocator    */
 			size_t         _quota_limit;
 			size_t         _quota_used;
 			size_t         _chunk_size;
+			size_t         _unused_size;  /* size of dataspaces without blocks */
+			size_t         _unused_limit;
 
 			/**
 			 * Try to allocate block at our local allocator
@@ -111,21 +320,36 @@ namespace Genode {
 			 */
 			bool _try_local_alloc(size_t size, void **out_addr);
 
+			/**
+			 * Release unused dataspaces exceeding the unused limit
+			 */
+			void _release_unused();
+
 		public:
 
 			enum { UNLIMITED = ~0 };
 
+			/**
+			 * Default size of unused dataspaces kept by the heap
+			 */
+			enum { DEFAULT_UNUSED_LIMIT = 64*1024 };
+
 			Heap(Ram_session *ram_session,
 			     Rm_session  *rm_session,
 			     size_t       quota_limit = UNLIMITED,
 			     void        *static_addr = 0,
 			     size_t       static_size = 0)
 			:
+				_md_alloc(ram_session, rm_session, _quota_limit, _quota_used),
 				_ds_pool(ram_session, rm_session),
-				_alloc(0),
+				_alloc(&_md_alloc),
 				_quota_limit(quota_limit), _quota_used(0),
-				_chunk_size(MIN_CHUNK_SIZE)
+				_chunk_size(MIN_CHUNK_SIZE),
+				_unused_size(0), _unused_limit(DEFAULT_UNUSED_LIMIT)
 			{
+				/* let slab blocks of the meta data free up chunks */
+				_alloc.release_empty_metadata_blocks(true);
+
 				if (static_addr)
 					_alloc.add_range((addr_t)static_addr, static_size);
 			}
@@ -138,10 +362,22 @@ namespace Genode {
 			 */
 			int quota_limit(size_t new_quota_limit);
 
+			/**
+			 * Define amount of memory kept in unused dataspaces
+			 *
+			 * Once all blocks within a backing-store dataspace are freed,
+			 * the dataspace is returned to the RAM session as soon as the
+			 * total size of unused dataspaces exceeds 'limit'. Keeping some
+			 * unused dataspaces avoids the repeated allocation and release
+			 * of dataspaces if the heap usage oscillates.
+			 */
+			void unused_limit(size_t limit);
+
 			/**
 			 * Re-assign RAM and RM sessions
 			 */
 			void reassign_resources(Ram_session *ram, Rm_session *rm) {
+				_md_alloc.reassign_resources(ram, rm);
 				_ds_pool.reassign_resources(ram, rm); }
 
 
@@ -157,6 +393,226 @@ namespace Genode {
 	};
 
 
+	/**
+	 * Heap with per-thread caches for small blocks
+	 *
+	 * The heap is a caching layer in front of an ordinary 'Heap'. Each thread
+	 * that allocates from the heap obtains a private cache holding two
+	 * magazines per size class. A magazine is a list of up to
+	 * 'MAGAZINE_SIZE' free blocks of the same size class. Allocations and
+	 * deallocations served by the magazines of the calling thread do not
+	 * acquire any lock. Whenever both magazines of a thread are full or
+	 * empty, the thread exchanges a whole magazine with a depot shared by
+	 * all threads. The depot returns surplus magazines to the backing heap.
+	 *
+	 * Each block is preceded by a header that records its size. Hence, the
+	 * heap does not depend on the size argument of 'free'. Blocks larger
+	 * than the biggest size class are passed through to the backing heap.
+	 * The main thread, which has no 'Thread_base' object, always uses the
+	 * backing heap directly.
+	 *
+	 * 'consumed' returns the number of bytes obtained from the backing heap,
+	 * which includes the blocks held in the caches of living threads. Before
+	 * reporting, the depot is returned to the backing heap. So once all
+	 * threads that used the heap are gone, the value covers allocated blocks
+	 * only. If an allocation exceeds the quota of the backing heap, the heap
+	 * drains the depot and retries. The caches of a thread are returned to the
+	 * depot on the destruction of the thread.
+	 */
+	class Thread_cached_heap : public Allocator,
+	                           public List<Thread_cached_heap>::Element
+	{
+		public:
+
+			enum {
+				MAX_THREADS   = 64,  /* threads with a private cache */
+				MAGAZINE_SIZE = 32,  /* blocks per magazine          */
+				DEPOT_SIZE    = 16,  /* full magazines per size class */
+			};
+
+		private:
+
+			enum { NUM_CLASSES = 13 };
+
+			/**
+			 * Meta data preceding each block
+			 */
+			struct Block
+			{
+				size_t size;    /* size of the block including this header */
+
+				/*
+				 * The following members are valid only while the block
+				 * resides in a magazine.
+				 */
+				Block *next;           /* next block of magazine          */
+				Block *next_magazine;  /* next magazine of depot (head)   */
+			};
+
+			struct Magazine
+			{
+				Block   *head;
+				unsigned count;
+
+				Magazine() : head(0), count(0) { }
+
+				bool empty() const { return count == 0; }
+				bool full()  const { return count == MAGAZINE_SIZE; }
+
+				void push(Block *b) { b->next = head; head = b; count++; }
+
+				Block *pop()
+				{
+					Block *b = head;
+					head = b->next;
+					count--;
+					return b;
+				}
+			};
+
+			/**
+			 * Cache of one thread, accessed by the owning thread only
+			 */
+			struct Thread_cache
+			{
+				Thread_base * volatile owner;
+
+				Magazine loaded[NUM_CLASSES];
+				Magazine previous[NUM_CLASSES];
+
+				Thread_cache() : owner(0) { }
+			};
+
+			Allocator &_heap;  /* backing store */
+
+			Thread_cache * volatile _caches[MAX_THREADS];
+			Lock                    _caches_lock;
+
+			/*
+			 * Depot of full magazines, one list per size class, and
+			 * accounting of the blocks obtained from the backing heap
+			 */
+			Lock     _lock;
+			Block   *_depot[NUM_CLASSES];
+			unsigned _depot_count[NUM_CLASSES];
+			size_t   _used;           /* bytes obtained from backing heap */
+
+			/**
+			 * Return size class of block, or -1 if the block is not cached
+			 */
+			static int _size_class(size_t block_size);
+
+			/**
+			 * Return block size of size class
+			 */
+			static size_t _class_size(int size_class);
+
+			/**
+			 * Return cache of the calling thread, or 0 if there is none
+			 */
+			Thread_cache *_thread_cache();
+
+			/**
+			 * Assign cache to the calling thread
+			 */
+			Thread_cache *_claim_thread_cache(Thread_base *myself, unsigned slot);
+
+			/**
+			 * Allocate block from backing heap
+			 *
+			 * \return  block, or 0 if the allocation failed
+			 */
+			Block *_alloc_block(size_t block_size);
+
+			/**
+			 * Return block to backing heap
+			 */
+			void _free_block(Block *block);
+
+			/**
+			 * Return all blocks of magazine to backing heap
+			 */
+			void _release_magazine(Magazine &magazine);
+
+			/**
+			 * Put full magazine into depot
+			 *
+			 * If the depot holds 'DEPOT_SIZE' magazines of the size class
+			 * already, the blocks are returned to the backing heap.
+			 */
+			void _deposit(int size_class, Magazine &magazine);
+
+			/**
+			 * Take full magazine from depot
+			 *
+			 * \return  false if the depot has no magazine of the size class
+			 */
+			bool _withdraw(int size_class, Magazine &magazine);
+
+			/**
+			 * Return all magazines of the depot to the backing heap
+			 */
+			void _drain_depot();
+
+			/**
+			 * Return all magazines of a thread cache
+			 */
+			void _flush(Thread_cache &cache);
+
+			/**
+			 * Return cache of the specified thread
+			 */
+			void _release_thread_cache(Thread_base *thread);
+
+		public:
+
+			/**
+			 * Constructor
+			 *
+			 * \param heap  backing heap used for the allocation of blocks
+			 *              and meta data
+			 */
+			Thread_cached_heap(Allocator &heap);
+
+			/**
+			 * Destructor
+			 *
+			 * Returns all cached blocks to the backing heap. Blocks that
+			 * are still allocated remain allocated at the backing heap.
+			 */
+			~Thread_cached_heap();
+
+			/**
+			 * Return caches of a thread to the depots of all heaps
+			 *
+			 * This function is called on the destruction of a thread.
+			 */
+			static void release_thread_caches(Thread_base *thread);
+
+			/**
+			 * Return number of bytes usable at the block at 'addr'
+			 *
+			 * The result is at least the size requested at allocation
+			 * time but may be larger because of the rounding to the size
+			 * class of the block.
+			 */
+			static size_t usable_size(void const *addr) {
+				return ((Block const *)((addr_t)addr - sizeof(size_t)))->size
+				       - sizeof(size_t); }
+
+
+			/*************************
+			 ** Allocator interface **
+			 *************************/
+
+			bool   alloc(size_t, void **);
+			void   free(void *, size_t);
+			size_t consumed();
+			size_t overhead(size_t size) { return _heap.overhead(size) + sizeof(size_t); }
+			bool   need_size_for_free() const { return false; }
+	};
+
+
 	/**
 	 * Heap that allocates each block at a separate dataspace
 	 */
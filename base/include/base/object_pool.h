@@ -18,6 +18,7 @@
 #include <util/avl_tree.h>
 #include <base/capability.h>
 #include <base/lock.h>
+#include <cpu/atomic.h>
 
 namespace Genode {
 
@@ -28,6 +29,13 @@ namespace Genode {
 	 *
 	 * The local names of a capabilities are used to differentiate multiple server
 	 * objects managed by one and the same object pool.
+	 *
+	 * The objects are partitioned by their ids into a number of AVL trees,
+	 * each protected by a lock of its own. Hence, concurrent lookups, e.g.,
+	 * by the threads of a multi-threaded entrypoint, do not contend for a
+	 * common lock. The lock of a partition is held only for the short
+	 * traversal of its tree. Lookups of the same object are serialized
+	 * anyway because 'lookup_and_lock' acquires the object.
 	 */
 	template <typename OBJ_TYPE>
 	class Object_pool
@@ -62,7 +70,7 @@ namespace Genode {
 				private:
 
 					Untyped_capability _cap;
-					short int          _ref;
+					int volatile       _ref;
 					bool               _dead;
 
 					Lock               _entry_lock;
@@ -79,8 +87,18 @@ namespace Genode {
 					void lock()   { _entry_lock.lock(); };
 					void unlock() { _entry_lock.unlock(); };
 
-					void add_ref() { _ref += 1; }
-					void del_ref() { _ref -= 1; }
+					/*
+					 * The reference counter is modified without holding the
+					 * lock of the object's partition, e.g., by 'release'.
+					 */
+					void _add_to_ref(int value)
+					{
+						int old;
+						do { old = _ref; } while (!cmpxchg(&_ref, old, old + value));
+					}
+
+					void add_ref() { _add_to_ref(1); }
+					void del_ref() { _add_to_ref(-1); }
 
 					bool is_dead(bool set_dead = false) {
 						return (set_dead ? (_dead = true) : _dead); }
@@ -130,28 +148,42 @@ namespace Genode {
 
 		private:
 
-			Avl_tree<Entry> _tree;
-			Lock            _lock;
+			enum { NUM_PARTITIONS = 16 };
+
+			struct Partition
+			{
+				Avl_tree<Entry> tree;
+				Lock            lock;
+			};
+
+			Partition _partitions[NUM_PARTITIONS];
+
+			Partition &_partition(unsigned long obj_id) {
+				return _partitions[obj_id % NUM_PARTITIONS]; }
 
 		public:
 
 			void insert(OBJ_TYPE *obj)
 			{
-				Lock::Guard lock_guard(_lock);
-				_tree.insert(obj);
+				Partition &partition = _partition(obj->_obj_id());
+
+				Lock::Guard lock_guard(partition.lock);
+				partition.tree.insert(obj);
 			}
 
 			void remove_locked(OBJ_TYPE *obj)
 			{
+				Partition &partition = _partition(obj->_obj_id());
+
 				obj->is_dead(true);
 				obj->del_ref();
 
 				while (true) {
 					obj->unlock();
 					{
-						Lock::Guard lock_guard(_lock);
+						Lock::Guard lock_guard(partition.lock);
 						if (obj->is_ref_zero()) {
-							_tree.remove(obj);
+							partition.tree.remove(obj);
 							return;
 						}
 					}
@@ -164,10 +196,13 @@ namespace Genode {
 			 */
 			OBJ_TYPE *lookup_and_lock(addr_t obj_id)
 			{
+				Partition &partition = _partition(obj_id);
+
 				OBJ_TYPE * obj_typed;
 				{
-					Lock::Guard lock_guard(_lock);
-					Entry *obj = _tree.first();
+					/* the reference counter is modified atomically */
+					Lock::Guard lock_guard(partition.lock);
+					Entry *obj = partition.tree.first();
 					if (!obj) return 0;
 
 					obj_typed = (OBJ_TYPE *)obj->find_by_obj_id(obj_id);
@@ -193,8 +228,12 @@ namespace Genode {
 			 */
 			OBJ_TYPE *first()
 			{
-				Lock::Guard lock_guard(_lock);
-				return (OBJ_TYPE *)_tree.first();
+				for (unsigned i = 0; i < NUM_PARTITIONS; i++) {
+					Lock::Guard lock_guard(_partitions[i].lock);
+					if (Entry *obj = _partitions[i].tree.first())
+						return (OBJ_TYPE *)obj;
+				}
+				return 0;
 			}
 	};
 }
@@ -15,6 +15,7 @@
 #define _INCLUDE__BASE__RPC_CLIENT_H_
 
 #include <base/ipc.h>
+#include <trace/events.h>
 
 namespace Genode {
 
@@ -121,7 +122,9 @@ namespace Genode {
 		_marshal_args(ipc_client, args);
 
 		/* perform RPC, unmarshal return value */
+		Trace::event(Trace::RPC_CALL, opcode, this->local_name());
 		ipc_client << IPC_CALL >> ret;
+		Trace::event(Trace::RPC_RETURNED, opcode, ipc_client.result());
 
 		/* unmarshal RPC output arguments */
 		_unmarshal_results(ipc_client, args);
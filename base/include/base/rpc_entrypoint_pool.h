@@ -0,0 +1,222 @@
+/*
+ * \brief  RPC entrypoint served by multiple threads
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_
+#define _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_
+
+#include <base/rpc_server.h>
+#include <base/allocator.h>
+
+namespace Genode {
+
+	/**
+	 * RPC entrypoint with a pool of worker threads
+	 *
+	 * The entrypoint consists of a primary thread and a number of additional
+	 * worker threads. All threads share the object pool of the primary
+	 * entrypoint. Hence, the entrypoint can be used wherever an ordinary
+	 * 'Rpc_entrypoint' is expected, e.g., for looking up local objects by
+	 * their capabilities.
+	 *
+	 * Because a capability always refers to one particular thread, each RPC
+	 * object is assigned to one of the threads when getting managed. By
+	 * default, the objects are distributed among all threads in a
+	 * round-robin fashion. Consequently, RPC objects may be dispatched
+	 * concurrently, which is a good fit for servers with per-client session
+	 * objects that do not share state. Requests for one and the same object
+	 * are always processed one after another.
+	 *
+	 * Objects that rely on being serialized with other objects can opt in
+	 * for serialization by being managed with the 'SERIALIZED' argument.
+	 * Such objects are always dispatched by the primary thread, which makes
+	 * them behave as if they were managed by an ordinary single-threaded
+	 * entrypoint.
+	 *
+	 * By convention, components obtain the number of threads from the
+	 * 'threads' attribute of the '<entrypoint>' node of their configuration.
+	 */
+	class Rpc_entrypoint_pool : public Rpc_entrypoint
+	{
+		public:
+
+			enum { MAX_THREADS = 16 };
+
+			enum Dispatch { DISTRIBUTED, SERIALIZED };
+
+		private:
+
+			Allocator      *_md_alloc;
+			unsigned const  _num_threads;
+			Rpc_entrypoint *_workers[MAX_THREADS - 1];
+			Lock            _next_lock;
+			unsigned        _next;   /* thread to assign next object to */
+
+			static unsigned _clamped(unsigned num_threads)
+			{
+				if (num_threads < 1)           return 1;
+				if (num_threads > MAX_THREADS) return MAX_THREADS;
+				return num_threads;
+			}
+
+			/**
+			 * Return entrypoint of the calling thread, or the primary
+			 * entrypoint if the caller is no thread of the pool
+			 */
+			Rpc_entrypoint &_myself_or_primary()
+			{
+				for (unsigned i = 0; i < _num_threads - 1; i++)
+					if (_workers[i]->is_myself())
+						return *_workers[i];
+
+				return *this;
+			}
+
+		protected:
+
+			/**
+			 * Assign RPC object to the next thread of the pool
+			 */
+			Untyped_capability _manage(Rpc_object_base *obj)
+			{
+				unsigned i;
+				{
+					Lock::Guard guard(_next_lock);
+					i     = _next;
+					_next = (_next + 1) % _num_threads;
+				}
+
+				return i ? _workers[i - 1]->_manage(obj)
+				         : Rpc_entrypoint::_manage(obj);
+			}
+
+			/**
+			 * Make the thread dispatching 'obj' leave the object
+			 *
+			 * The object may be in use by any thread of the pool.
+			 */
+			void _leave_server_object(Rpc_object_base *obj)
+			{
+				Rpc_entrypoint::_leave_server_object(obj);
+
+				for (unsigned i = 0; i < _num_threads - 1; i++)
+					_workers[i]->_leave_server_object(obj);
+			}
+
+		public:
+
+			/**
+			 * Constructor
+			 *
+			 * \param cap_session  'Cap_session' for creating capabilities
+			 *                     for the RPC objects managed by this
+			 *                     entrypoint
+			 * \param stack_size   stack size of each thread
+			 * \param name         name of the entrypoint threads
+			 * \param num_threads  number of threads including the primary
+			 *                     thread, at most 'MAX_THREADS'
+			 * \param md_alloc     meta-data allocator used for the worker
+			 *                     threads
+			 */
+			Rpc_entrypoint_pool(Cap_session *cap_session, size_t stack_size,
+			                    char const *name, unsigned num_threads,
+			                    Allocator *md_alloc,
+			                    bool start_on_construction = true)
+			:
+				Rpc_entrypoint(cap_session, stack_size, name,
+				               start_on_construction),
+				_md_alloc(md_alloc), _num_threads(_clamped(num_threads)),
+				_next(0)
+			{
+				for (unsigned i = 0; i < _num_threads - 1; i++)
+					_workers[i] = new (_md_alloc)
+						Rpc_entrypoint(cap_session, stack_size, name,
+						               start_on_construction, this);
+			}
+
+			~Rpc_entrypoint_pool()
+			{
+				for (unsigned i = 0; i < _num_threads - 1; i++)
+					destroy(_md_alloc, _workers[i]);
+			}
+
+			/**
+			 * Associate RPC object with the entrypoint
+			 *
+			 * \param dispatch  'SERIALIZED' to dispatch the object by the
+			 *                  primary thread only
+			 */
+			template <typename RPC_INTERFACE, typename RPC_SERVER>
+			Capability<RPC_INTERFACE>
+			manage(Rpc_object<RPC_INTERFACE, RPC_SERVER> *obj, Dispatch dispatch)
+			{
+				if (dispatch == SERIALIZED)
+					return reinterpret_cap_cast<RPC_INTERFACE>(Rpc_entrypoint::_manage(obj));
+
+				return Rpc_entrypoint::manage(obj);
+			}
+
+			using Rpc_entrypoint::manage;
+
+			/**
+			 * Return number of threads serving the entrypoint
+			 */
+			unsigned num_threads() const { return _num_threads; }
+
+
+			/******************************
+			 ** Rpc_entrypoint interface **
+			 ******************************/
+
+			void activate()
+			{
+				Rpc_entrypoint::activate();
+
+				for (unsigned i = 0; i < _num_threads - 1; i++)
+					_workers[i]->activate();
+			}
+
+			Untyped_capability reply_dst()
+			{
+				Rpc_entrypoint &ep = _myself_or_primary();
+				return &ep == this ? Rpc_entrypoint::reply_dst() : ep.reply_dst();
+			}
+
+			void omit_reply()
+			{
+				Rpc_entrypoint &ep = _myself_or_primary();
+				if (&ep == this) Rpc_entrypoint::omit_reply();
+				else             ep.omit_reply();
+			}
+
+			void explicit_reply(Untyped_capability reply_cap, int return_value)
+			{
+				Rpc_entrypoint &ep = _myself_or_primary();
+				if (&ep == this) Rpc_entrypoint::explicit_reply(reply_cap, return_value);
+				else             ep.explicit_reply(reply_cap, return_value);
+			}
+
+			bool is_myself() const
+			{
+				if (Rpc_entrypoint::is_myself())
+					return true;
+
+				for (unsigned i = 0; i < _num_threads - 1; i++)
+					if (_workers[i]->is_myself())
+						return true;
+
+				return false;
+			}
+	};
+}
+
+#endif /* _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_ */
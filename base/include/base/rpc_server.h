@@ -269,8 +269,19 @@ namespace Genode {
 				void _exit() { exit = true; }
 			};
 
+			friend class Rpc_entrypoint_pool;
+
 		protected:
 
+			/**
+			 * Object pool used for looking up the targets of RPC requests
+			 *
+			 * Normally, this is the entrypoint itself. The worker threads of
+			 * an 'Rpc_entrypoint_pool' share the object pool of the primary
+			 * entrypoint.
+			 */
+			Object_pool<Rpc_object_base> &_pool;
+
 			Ipc_server      *_ipc_server;
 			Rpc_object_base *_curr_obj;       /* currently dispatched RPC object       */
 			Lock             _curr_obj_lock;  /* for the protection of '_curr_obj'     */
@@ -284,7 +295,7 @@ namespace Genode {
 			/**
 			 * Back-end function to associate RPC object with the entry point
 			 */
-			Untyped_capability _manage(Rpc_object_base *obj);
+			virtual Untyped_capability _manage(Rpc_object_base *obj);
 
 			/**
 			 * Back-end function to Dissolve RPC object from entry point
@@ -294,7 +305,7 @@ namespace Genode {
 			/**
 			 * Force activation to cancel dispatching the specified server object
 			 */
-			void _leave_server_object(Rpc_object_base *obj);
+			virtual void _leave_server_object(Rpc_object_base *obj);
 
 			/**
 			 * Wait until the entrypoint activation is initialized
@@ -316,11 +327,15 @@ namespace Genode {
 			 *                     point
 			 * \param stack_size   stack size of entrypoint thread
 			 * \param name         name of entrypoint thread
+			 * \param pool         object pool to share with another
+			 *                     entrypoint, or 0 to use the entrypoint's
+			 *                     own object pool
 			 */
 			Rpc_entrypoint(Cap_session *cap_session, size_t stack_size,
-			               char const *name, bool start_on_construction = true);
+			               char const *name, bool start_on_construction = true,
+			               Object_pool<Rpc_object_base> *pool = 0);
 
-			~Rpc_entrypoint();
+			virtual ~Rpc_entrypoint();
 
 			/**
 			 * Associate RPC object with the entry point
@@ -344,7 +359,7 @@ namespace Genode {
 			/**
 			 * Activate entrypoint, start processing RPC requests
 			 */
-			void activate();
+			virtual void activate();
 
 			/**
 			 * Request reply capability for current call
@@ -355,7 +370,7 @@ namespace Genode {
 			 * Typically, a capability obtained via this function is used as
 			 * argument of 'intermediate_reply'.
 			 */
-			Untyped_capability reply_dst();
+			virtual Untyped_capability reply_dst();
 
 			/**
 			 * Prevent reply of current request
@@ -368,7 +383,7 @@ namespace Genode {
 			 * request. At a later time, the server may chose to unblock the
 			 * client via the 'intermedate_reply' function.
 			 */
-			void omit_reply();
+			virtual void omit_reply();
 
 			/**
 			 * Send a reply out of the normal call-reply order
@@ -382,12 +397,12 @@ namespace Genode {
 			 * send reply messages to multiple blocking clients before
 			 * answering the original call.
 			 */
-			void explicit_reply(Untyped_capability reply_cap, int return_value);
+			virtual void explicit_reply(Untyped_capability reply_cap, int return_value);
 
 			/**
 			 * Return true if the caller corresponds to the entrypoint called
 			 */
-			bool is_myself() const;
+			virtual bool is_myself() const;
 	};
 }
 
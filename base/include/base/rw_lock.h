@@ -0,0 +1,237 @@
+/*
+ * \brief  Reader-writer lock
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__RW_LOCK_H_
+#define _INCLUDE__BASE__RW_LOCK_H_
+
+#include <base/lock.h>
+#include <util/fifo.h>
+
+namespace Genode {
+
+	/**
+	 * Lock that admits either multiple readers or one writer
+	 *
+	 * Writers take precedence over readers. Once a writer is waiting for the
+	 * lock, new readers are blocked until the writer released the lock.
+	 * Hence, a constant stream of readers cannot starve writers.
+	 *
+	 * A reader can upgrade its read access to write access without releasing
+	 * the lock in between. Because two readers trying to upgrade at the same
+	 * time would wait for each other, only one upgrade can be pending at a
+	 * time. A pending upgrade takes precedence over waiting writers.
+	 */
+	class Rw_lock
+	{
+		private:
+
+			/**
+			 * Thread blocking for the lock
+			 */
+			class Waiter : Lock, public Fifo<Waiter>::Element
+			{
+				public:
+
+					Waiter() : Lock(LOCKED) { }
+
+					void block()   { lock();   }
+					void wake_up() { unlock(); }
+			};
+
+			Lock         _meta_lock;
+			int          _readers;          /* number of active readers */
+			bool         _writer;           /* true if a writer is active */
+			Fifo<Waiter> _waiting_readers;
+			Fifo<Waiter> _waiting_writers;
+			unsigned     _num_waiting_writers;
+			Waiter      *_upgrader;         /* reader waiting for upgrade */
+
+			/**
+			 * Hand over the lock after the last user left
+			 *
+			 * Must be called with '_meta_lock' held.
+			 */
+			void _wake_up_next()
+			{
+				if (_upgrader) {
+					_writer = true;
+					_upgrader->wake_up();
+					_upgrader = 0;
+					return;
+				}
+
+				if (Waiter *writer = _waiting_writers.dequeue()) {
+					_num_waiting_writers--;
+					_writer = true;
+					writer->wake_up();
+					return;
+				}
+
+				while (Waiter *reader = _waiting_readers.dequeue()) {
+					_readers++;
+					reader->wake_up();
+				}
+			}
+
+			/**
+			 * Enqueue waiter, release '_meta_lock', and block
+			 */
+			void _block(Fifo<Waiter> &queue)
+			{
+				Waiter waiter;
+				queue.enqueue(&waiter);
+				_meta_lock.unlock();
+
+				/* the lock is handed over to us when woken up */
+				waiter.block();
+			}
+
+		public:
+
+			Rw_lock()
+			: _readers(0), _writer(false), _num_waiting_writers(0), _upgrader(0) { }
+
+			~Rw_lock()
+			{
+				/* synchronize destruction with unfinished unlock operations */
+				_meta_lock.lock();
+			}
+
+			/**
+			 * Acquire lock for reading
+			 */
+			void lock_read()
+			{
+				_meta_lock.lock();
+
+				if (_writer || _num_waiting_writers || _upgrader) {
+					_block(_waiting_readers);
+					return;
+				}
+
+				_readers++;
+				_meta_lock.unlock();
+			}
+
+			/**
+			 * Release read access
+			 */
+			void unlock_read()
+			{
+				Lock::Guard guard(_meta_lock);
+
+				if (--_readers == 0)
+					_wake_up_next();
+			}
+
+			/**
+			 * Acquire lock for writing
+			 */
+			void lock_write()
+			{
+				_meta_lock.lock();
+
+				if (_writer || _readers) {
+					_num_waiting_writers++;
+					_block(_waiting_writers);
+					return;
+				}
+
+				_writer = true;
+				_meta_lock.unlock();
+			}
+
+			/**
+			 * Release write access
+			 */
+			void unlock_write()
+			{
+				Lock::Guard guard(_meta_lock);
+
+				_writer = false;
+				_wake_up_next();
+			}
+
+			/**
+			 * Upgrade read access to write access
+			 *
+			 * \return true if the caller holds write access now, false if
+			 *         another upgrade is pending. In the latter case, the
+			 *         caller still holds read access and should release it
+			 *         before acquiring write access via 'lock_write'.
+			 *
+			 * Once the upgrade succeeded, the lock must be released via
+			 * 'unlock_write'.
+			 */
+			bool upgrade()
+			{
+				_meta_lock.lock();
+
+				if (_upgrader) {
+					_meta_lock.unlock();
+					return false;
+				}
+
+				/* we are the only reader */
+				if (--_readers == 0) {
+					_writer = true;
+					_meta_lock.unlock();
+					return true;
+				}
+
+				/* wait for the other readers to leave */
+				Waiter waiter;
+				_upgrader = &waiter;
+				_meta_lock.unlock();
+
+				waiter.block();
+				return true;
+			}
+
+			/**
+			 * Guard for read access
+			 */
+			class Read_guard
+			{
+				private:
+
+					Rw_lock &_lock;
+
+				public:
+
+					explicit Read_guard(Rw_lock &lock) : _lock(lock) {
+						_lock.lock_read(); }
+
+					~Read_guard() { _lock.unlock_read(); }
+			};
+
+			/**
+			 * Guard for write access
+			 */
+			class Write_guard
+			{
+				private:
+
+					Rw_lock &_lock;
+
+				public:
+
+					explicit Write_guard(Rw_lock &lock) : _lock(lock) {
+						_lock.lock_write(); }
+
+					~Write_guard() { _lock.unlock_write(); }
+			};
+	};
+}
+
+#endif /* _INCLUDE__BASE__RW_LOCK_H_ */
@@ -17,6 +17,7 @@
 #ifndef _INCLUDE__BASE__SIGNAL_H__
 #define _INCLUDE__BASE__SIGNAL_H__
 
+#include <util/fifo.h>
 #include <base/semaphore.h>
 #include <signal_session/signal_session.h>
 
@@ -123,6 +124,11 @@ namespace Genode {
 			 */
 			List_element<Signal_context> _registry_le;
 
+			/**
+			 * Element in the queue of pending contexts of 'Signal_receiver'
+			 */
+			Fifo_element<Signal_context> _pending_fe;
+
 			/**
 			 * Receiver to which the context is associated with
 			 *
@@ -157,7 +163,7 @@ namespace Genode {
 			 * Constructor
 			 */
 			Signal_context()
-			: _receiver_le(this), _registry_le(this),
+			: _receiver_le(this), _registry_le(this), _pending_fe(this),
 			  _receiver(0), _pending(0), _ref_cnt(0) { }
 
 			/**
@@ -241,6 +247,22 @@ namespace Genode {
 			Lock                                _contexts_lock;
 			List<List_element<Signal_context> > _contexts;
 
+			/**
+			 * Queue of contexts with a pending signal
+			 *
+			 * A context is appended to the queue when becoming pending and
+			 * removed when its signal is picked up by 'wait_for_signal'.
+			 * Hence, the contexts are served in a round-robin fashion and
+			 * neither the delivery nor the reception of a signal depends on
+			 * the number of contexts associated with the receiver. The queue
+			 * is needed for platforms other than 'base-hw' only.
+			 *
+			 * The '_pending_lock' must be acquired after '_contexts_lock' and
+			 * after the '_lock' of a context.
+			 */
+			Lock                                _pending_lock;
+			Fifo<Fifo_element<Signal_context> > _pending_contexts;
+
 			/**
 			 * Helper to dissolve given context
 			 *
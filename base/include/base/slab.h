@@ -37,8 +37,9 @@ namespace Genode {
 
 			enum { FREE, USED };
 
-			Slab    *_slab;    /* back reference to slab allocator */
-			unsigned _avail;   /* free entries of this block       */
+			Slab       *_slab;   /* back reference to slab allocator */
+			unsigned    _avail;  /* free entries of this block       */
+			Slab_entry *_free;   /* first entry of free list         */
 
 			/*
 			 * Each slab block consists of three areas, a fixed-size header
@@ -48,6 +49,10 @@ namespace Genode {
 			 * of state-table elements corresponds to the maximum number of slab
 			 * entries per slab block (the '_num_elem' member variable of the
 			 * Slab allocator).
+			 *
+			 * The free entries of the block are chained to a list, which
+			 * makes allocating and freeing an entry a constant-time operation.
+			 * The state table is merely needed to find used entries.
 			 */
 
 			char _data[];  /* dynamic data (state table and slab entries) */
@@ -122,8 +127,14 @@ namespace Genode {
 	{
 		private:
 
-			Slab_block *_sb;
-			char        _data[];
+			friend class Slab_block;
+
+			union {
+				Slab_block *_sb;         /* block of used entry            */
+				Slab_entry *_next_free;  /* next free entry of same block */
+			};
+
+			char _data[];
 
 			/*
 			 * Caution! no member variables allowed below this line!
@@ -139,11 +150,7 @@ namespace Genode {
 				_sb->dec_avail();
 			}
 
-			void free()
-			{
-				_sb->inc_avail(this);
-				_sb = 0;
-			}
+			void free() { _sb->inc_avail(this); }
 
 			void *addr() { return _data; }
 
@@ -164,12 +171,24 @@ namespace Genode {
 	{
 		private:
 
+			friend class Slab_block;
+
+			/**
+			 * Lists of slab blocks, distinguished by their number of
+			 * available entries
+			 */
+			enum Bucket { EMPTY, PARTIAL, FULL, NUM_BUCKETS };
+
 			size_t      _slab_size;     /* size of one slab entry               */
 			size_t      _block_size;    /* size of slab block                   */
 			size_t      _num_elem;      /* number of slab entries per block     */
-			Slab_block *_first_sb;      /* first slab block                     */
+			size_t      _num_free;      /* number of free entries of all blocks */
+			size_t      _num_blocks;    /* number of slab blocks                */
 			Slab_block *_initial_sb;    /* initial (static) slab block          */
 			bool        _alloc_state;   /* indicator for 'currently in service' */
+			bool        _release_empty; /* return surplus empty blocks          */
+
+			Slab_block *_blocks[NUM_BUCKETS];
 
 			Allocator *_backing_store;
 
@@ -178,6 +197,45 @@ namespace Genode {
 			 */
 			Slab_block *_new_slab_block();
 
+			/**
+			 * Return list that holds blocks with 'avail' available entries
+			 */
+			Bucket _bucket(size_t avail) const
+			{
+				if (avail == 0)         return FULL;
+				if (avail == _num_elem) return EMPTY;
+				return PARTIAL;
+			}
+
+			/**
+			 * Add block to the list that corresponds to its availability
+			 */
+			void _insert_sb(Slab_block *sb);
+
+			/**
+			 * Remove block from the specified list
+			 */
+			void _remove_sb(Slab_block *sb, Bucket bucket);
+
+			/**
+			 * Add new block to the slab
+			 */
+			void _add_sb(Slab_block *sb);
+
+			/**
+			 * Update accounting and block lists after allocating or freeing
+			 * an entry of the specified block
+			 *
+			 * \param old_avail  number of available entries of the block
+			 *                   before the operation
+			 */
+			void _avail_changed(Slab_block *sb, size_t old_avail);
+
+			/**
+			 * Return surplus empty block to the backing store
+			 */
+			void _release_empty_block();
+
 		public:
 
 			inline size_t slab_size()  { return _slab_size;  }
@@ -206,16 +264,6 @@ namespace Genode {
 			 */
 			void dump_sb_list();
 
-			/**
-			 * Remove block from slab block list
-			 */
-			void remove_sb(Slab_block *sb);
-
-			/**
-			 * Insert block into slab block list
-			 */
-			void insert_sb(Slab_block *sb, Slab_block *at = 0);
-
 			/**
 			 * Allocate slab entry
 			 */
@@ -236,6 +284,18 @@ namespace Genode {
 			 */
 			bool num_free_entries_higher_than(int n);
 
+			/**
+			 * Enable the return of surplus empty blocks to the backing store
+			 *
+			 * By default, slab blocks are kept once allocated. If enabled,
+			 * freeing the last entry of a block returns the block to the
+			 * backing store, except for one empty block. This must not be
+			 * enabled if the backing store uses this slab for its own meta
+			 * data because the backing store would be re-entered in the
+			 * middle of an operation.
+			 */
+			void release_empty_blocks(bool enabled) { _release_empty = enabled; }
+
 			/**
 			 * Define/request backing-store allocator
 			 */
@@ -58,6 +58,7 @@
 #include <util/list.h>
 #include <ram_session/ram_session.h>  /* for 'Ram_dataspace_capability' type */
 #include <cpu_session/cpu_session.h>  /* for 'Thread_capability' type */
+#include <trace/logger.h>
 
 
 namespace Genode {
@@ -121,6 +122,11 @@ namespace Genode {
 				 */
 				Ram_dataspace_capability ds_cap;
 
+				/**
+				 * Size of the dataspace backing the thread context
+				 */
+				size_t ds_size;
+
 				/**
 				 * Maximum length of thread name, including null-termination
 				 */
@@ -151,14 +157,30 @@ namespace Genode {
 			 * Manage the allocation of thread contexts
 			 *
 			 * There exists only one instance of this class per process.
+			 *
+			 * The contexts of destroyed threads are not released right away
+			 * but kept, including their attached backing store, for the
+			 * creation of subsequent threads. This way, patterns like
+			 * creating a thread per request do not involve core for the
+			 * thread context. The cache holds up to 'MAX_RECYCLED' contexts
+			 * with backing stores of 'MAX_RECYCLED_SIZE' bytes in total.
 			 */
 			class Context_allocator
 			{
+				public:
+
+					enum { MAX_RECYCLED = 8, MAX_RECYCLED_SIZE = 256*1024 };
+
 				private:
 
 					List<List_element<Thread_base> > _threads;
 					Lock                             _threads_lock;
 
+					/* contexts of destroyed threads kept for reuse */
+					Context *_recycled[MAX_RECYCLED];
+					unsigned _num_recycled;
+					size_t   _recycled_size;  /* backing store of cached contexts */
+
 					/**
 					 * Detect if a context already exists at the specified address
 					 */
@@ -166,6 +188,8 @@ namespace Genode {
 
 				public:
 
+					Context_allocator() : _num_recycled(0), _recycled_size(0) { }
+
 					/**
 					 * Allocate thread context for specified thread
 					 *
@@ -175,11 +199,32 @@ namespace Genode {
 					 */
 					Context *alloc(Thread_base *thread);
 
+					/**
+					 * Allocate cached thread context for specified thread
+					 *
+					 * \param thread   thread for which to allocate the context
+					 * \param ds_size  size of the backing store needed by the
+					 *                 thread
+					 * \return         context with attached backing store of
+					 *                 'ds_size', or 0 if no such context is
+					 *                 cached
+					 */
+					Context *alloc_recycled(Thread_base *thread, size_t ds_size);
+
 					/**
 					 * Release thread context
 					 */
 					void free(Thread_base *thread);
 
+					/**
+					 * Keep thread context of destructed thread for reuse
+					 *
+					 * \return  false if the cache is full or the context is too
+					 *          large, in which case the context must be
+					 *          released via 'free'
+					 */
+					bool recycle(Thread_base *thread);
+
 					/**
 					 * Return 'Context' object for a given base address
 					 */
@@ -202,7 +247,8 @@ namespace Genode {
 			Context *_alloc_context(size_t stack_size);
 
 			/**
-			 * Detach and release thread context of the thread
+			 * Detach and release thread context of the thread, or keep it
+			 * for reuse
 			 */
 			void _free_context();
 
@@ -259,6 +305,11 @@ namespace Genode {
 			 */
 			Genode::Lock _join_lock;
 
+			/**
+			 * Buffer for recording the trace events of the thread
+			 */
+			Trace::Logger _trace_logger;
+
 		public:
 
 			/**
@@ -332,6 +383,11 @@ namespace Genode {
 			 */
 			static Thread_base *myself();
 
+			/**
+			 * Return trace buffer of the thread
+			 */
+			Trace::Logger *trace_logger() { return &_trace_logger; }
+
 			/**
 			 * Return user-level thread control block
 			 *
@@ -30,6 +30,9 @@ namespace Genode {
 
 		void free(Ram_dataspace_capability ds) { call<Rpc_free>(ds); }
 
+		Ram_dataspace_capability clone(Ram_dataspace_capability ds) {
+			return call<Rpc_clone>(ds); }
+
 		int ref_account(Ram_session_capability ram_session) {
 			return call<Rpc_ref_account>(ram_session); }
 
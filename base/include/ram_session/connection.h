@@ -25,12 +25,18 @@ namespace Genode {
 		/**
 		 * Constructor
 		 *
-		 * \param label  session label
+		 * \param label           session label
+		 * \param huge_pages_min  minimum size of dataspaces to be backed by
+		 *                        huge pages, 0 disables huge pages
+		 *
+		 * The use of huge pages is a hint that is honored only by platforms
+		 * supporting it.
 		 */
-		Ram_connection(const char *label = "")
+		Ram_connection(const char *label = "", size_t huge_pages_min = 0)
 		:
 			Connection<Ram_session>(
-				session("ram_quota=64K, label=\"%s\"", label)),
+				session("ram_quota=64K, label=\"%s\", huge_pages_min=%zd",
+				        label, huge_pages_min)),
 
 			Ram_session_client(cap())
 		{ }
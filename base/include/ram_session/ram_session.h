@@ -31,6 +31,11 @@ namespace Genode {
 	{
 		static const char *service_name() { return "RAM"; }
 
+		/**
+		 * Maximum size of a dataspace copied via 'clone'
+		 */
+		enum { MAX_CLONE_SIZE = 16*1024*1024 };
+
 
 		/*********************
 		 ** Exception types **
@@ -66,6 +71,30 @@ namespace Genode {
 		 */
 		virtual void free(Ram_dataspace_capability ds) = 0;
 
+		/**
+		 * Create core-side copy of RAM dataspace
+		 *
+		 * \param  ds  dataspace to copy, must have been allocated from
+		 *             this RAM session
+		 *
+		 * \throw  Quota_exceeded
+		 * \throw  Out_of_metadata
+		 * \return capability to new RAM dataspace, or invalid capability if
+		 *         'ds' is not a dataspace of this session, 'ds' is larger
+		 *         than 'MAX_CLONE_SIZE', or the platform does not support
+		 *         copying dataspaces
+		 *
+		 * The new dataspace is accounted to this RAM session and has the
+		 * same caching attribute as 'ds'. Where possible, only the parts of
+		 * 'ds' that were ever populated are copied, so the costs depend on
+		 * the memory actually used rather than on the size of 'ds'. The
+		 * copy is performed eagerly and synchronously by core, which is why
+		 * the size of 'ds' is bounded. The pages are not shared
+		 * copy-on-write. If the operation is not supported, the caller
+		 * must fall back to allocating and copying the dataspace itself.
+		 */
+		virtual Ram_dataspace_capability clone(Ram_dataspace_capability ds) = 0;
+
 		/**
 		 * Define reference account for the RAM session
 		 *
@@ -118,13 +147,16 @@ namespace Genode {
 		                 GENODE_TYPE_LIST(Quota_exceeded, Out_of_metadata),
 		                 size_t, bool);
 		GENODE_RPC(Rpc_free, void, free, Ram_dataspace_capability);
+		GENODE_RPC_THROW(Rpc_clone, Ram_dataspace_capability, clone,
+		                 GENODE_TYPE_LIST(Quota_exceeded, Out_of_metadata),
+		                 Ram_dataspace_capability);
 		GENODE_RPC(Rpc_ref_account, int, ref_account, Ram_session_capability);
 		GENODE_RPC(Rpc_transfer_quota, int, transfer_quota, Ram_session_capability, size_t);
 		GENODE_RPC(Rpc_quota, size_t, quota);
 		GENODE_RPC(Rpc_used, size_t, used);
 
 		GENODE_RPC_INTERFACE(Rpc_alloc, Rpc_free, Rpc_ref_account,
-		                     Rpc_transfer_quota, Rpc_quota, Rpc_used);
+		                     Rpc_transfer_quota, Rpc_quota, Rpc_used, Rpc_clone);
 	};
 }
 
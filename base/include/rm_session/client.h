@@ -27,16 +27,24 @@ namespace Genode {
 		Local_addr attach(Dataspace_capability ds, size_t size = 0,
 		                  off_t offset = 0, bool use_local_addr = false,
 		                  Local_addr local_addr = 0,
-		                  bool executable = false)
+		                  bool executable = false,
+		                  bool populate = false)
 		{
 			return call<Rpc_attach>(ds, size, offset,
 			                        use_local_addr, local_addr,
-			                        executable);
+			                        executable, populate);
 		}
 
 		void detach(Local_addr local_addr) {
 			call<Rpc_detach>(local_addr); }
 
+		Local_addr_batch attach_many(Dataspace_capability ds,
+		                             Attachment_batch const &batch) {
+			return call<Rpc_attach_many>(ds, batch); }
+
+		void detach_many(Local_addr_batch const &batch) {
+			call<Rpc_detach_many>(batch); }
+
 		Pager_capability add_client(Thread_capability thread) {
 			return call<Rpc_add_client>(thread); }
 
@@ -86,6 +86,94 @@ namespace Genode {
 		};
 
 
+		/**
+		 * Maximum number of regions per 'attach_many' or 'detach_many'
+		 *
+		 * The batch is transferred in the message registers of the UTCB.
+		 * With eight attachments of five words each, the request occupies
+		 * about 45 words including the opcode and the dataspace
+		 * capability. This fits the 63 message words of Fiasco.OC, which
+		 * is the tightest limit of the supported kernels, on both 32-bit
+		 * and 64-bit platforms. Sixteen attachments would not fit.
+		 */
+		enum { MAX_BATCH = 8 };
+
+		/**
+		 * Portion of a dataspace to be attached by 'attach_many'
+		 *
+		 * The members correspond to the arguments of 'attach'.
+		 */
+		struct Attachment
+		{
+			size_t size;
+			off_t  offset;
+			bool   use_local_addr;
+			addr_t local_addr;
+			bool   executable;
+			bool   populate;
+
+			Attachment(size_t size = 0, off_t offset = 0,
+			           bool use_local_addr = false, addr_t local_addr = 0,
+			           bool executable = false,
+			           bool populate = false)
+			:
+				size(size), offset(offset), use_local_addr(use_local_addr),
+				local_addr(local_addr), executable(executable),
+				populate(populate)
+			{ }
+		};
+
+		/**
+		 * Batch of attachments passed to 'attach_many'
+		 */
+		struct Attachment_batch
+		{
+			unsigned count;
+			Attachment attachment[MAX_BATCH];
+
+			Attachment_batch() : count(0) { }
+
+			/**
+			 * Append region to batch
+			 *
+			 * \return false if the batch is full
+			 */
+			bool add(Attachment const &a)
+			{
+				if (count >= MAX_BATCH)
+					return false;
+
+				attachment[count++] = a;
+				return true;
+			}
+		};
+
+		/**
+		 * Batch of local addresses as returned by 'attach_many' and passed
+		 * to 'detach_many'
+		 */
+		struct Local_addr_batch
+		{
+			unsigned count;
+			addr_t   addr[MAX_BATCH];
+
+			Local_addr_batch() : count(0) { }
+
+			/**
+			 * Append address to batch
+			 *
+			 * \return false if the batch is full
+			 */
+			bool add(addr_t a)
+			{
+				if (count >= MAX_BATCH)
+					return false;
+
+				addr[count++] = a;
+				return true;
+			}
+		};
+
 		static const char *service_name() { return "RM"; }
 
 
@@ -118,6 +206,7 @@ namespace Genode {
 		 *                         the specified 'local_addr'
 		 * \param local_addr       local destination address
 		 * \param executable       if the mapping should be executable
+		 * \param populate         if the mapping should be populated eagerly
 		 *
 		 * \throw Attach_failed    if dataspace or offset is invalid,
 		 *                         or on region conflict
@@ -125,12 +214,19 @@ namespace Genode {
 		 *
 		 * \return                 local address of mapped dataspace
 		 *
+		 * The 'populate' argument is a hint for dataspaces that are about to
+		 * be accessed as a whole. It avoids the costs of resolving one page
+		 * fault after another on the first access. On Linux, the memory is
+		 * populated when attached. On Fiasco.OC, core maps the region into
+		 * the address space of the threads using the RM session at attach
+		 * time. On other kernels, the hint is ignored.
 		 */
 		virtual Local_addr attach(Dataspace_capability ds,
 		                          size_t size = 0, off_t offset = 0,
 		                          bool use_local_addr = false,
 		                          Local_addr local_addr = (void *)0,
-		                          bool executable = false) = 0;
+		                          bool executable = false,
+		                          bool populate = false) = 0;
 
 		/**
 		 * Shortcut for attaching a dataspace at a predefined local address
@@ -146,11 +242,68 @@ namespace Genode {
 		                             size_t size = 0, off_t offset = 0) {
 			return attach(ds, size, offset, true, local_addr, true); }
 
+		/**
+		 * Shortcut for attaching a dataspace with eagerly populated mapping
+		 */
+		Local_addr attach_populated(Dataspace_capability ds,
+		                            size_t size = 0, off_t offset = 0) {
+			return attach(ds, size, offset, false, (void *)0, false, true); }
+
 		/**
 		 * Remove region from local address space
 		 */
 		virtual void detach(Local_addr local_addr) = 0;
 
+		/**
+		 * Map several portions of a dataspace with a single operation
+		 *
+		 * \param ds     capability of dataspace to map
+		 * \param batch  regions to attach, at most 'MAX_BATCH'
+		 *
+		 * \throw Attach_failed    if dataspace or offset is invalid,
+		 *                         or on region conflict
+		 * \throw Out_of_metadata  if meta-data backing store is exhausted
+		 *
+		 * \return local addresses of the regions in the order of 'batch'
+		 *
+		 * The regions of a batch are attached as a whole. If one region
+		 * cannot be attached, the regions attached so far are detached
+		 * before the exception is propagated. The batch refers to a single
+		 * dataspace because the number of capabilities transferable with
+		 * one RPC is limited on some kernels. The default implementation
+		 * attaches one region after the other. The RPC client and core
+		 * perform the operation with a single round trip.
+		 */
+		virtual Local_addr_batch attach_many(Dataspace_capability ds,
+		                                     Attachment_batch const &batch)
+		{
+			Local_addr_batch result;
+			unsigned const count = batch.count < (unsigned)MAX_BATCH
+			                     ? batch.count : (unsigned)MAX_BATCH;
+			try {
+				for (unsigned i = 0; i < count; i++) {
+					Attachment const &a = batch.attachment[i];
+					result.add(attach(ds, a.size, a.offset, a.use_local_addr,
+					                  a.local_addr, a.executable, a.populate));
+				}
+			} catch (...) {
+				detach_many(result);
+				throw;
+			}
+			return result;
+		}
+
+		/**
+		 * Remove several regions from local address space
+		 *
+		 * \param batch  local addresses of the regions, at most 'MAX_BATCH'
+		 */
+		virtual void detach_many(Local_addr_batch const &batch)
+		{
+			for (unsigned i = 0; i < batch.count && i < MAX_BATCH; i++)
+				detach(batch.addr[i]);
+		}
+
 		/**
 		 * Add client to pager
 		 *
@@ -201,7 +354,7 @@ namespace Genode {
 		GENODE_RPC_THROW(Rpc_attach, Local_addr, attach,
 		                 GENODE_TYPE_LIST(Invalid_dataspace, Region_conflict,
 		                                  Out_of_metadata, Invalid_args),
-		                 Dataspace_capability, size_t, off_t, bool, Local_addr, bool);
+		                 Dataspace_capability, size_t, off_t, bool, Local_addr, bool, bool);
 		GENODE_RPC(Rpc_detach, void, detach, Local_addr);
 		GENODE_RPC_THROW(Rpc_add_client, Pager_capability, add_client,
 		                 GENODE_TYPE_LIST(Invalid_thread, Out_of_metadata),
@@ -210,10 +363,15 @@ namespace Genode {
 		GENODE_RPC(Rpc_fault_handler, void, fault_handler, Signal_context_capability);
 		GENODE_RPC(Rpc_state, State, state);
 		GENODE_RPC(Rpc_dataspace, Dataspace_capability, dataspace);
+		GENODE_RPC_THROW(Rpc_attach_many, Local_addr_batch, attach_many,
+		                 GENODE_TYPE_LIST(Invalid_dataspace, Region_conflict,
+		                                  Out_of_metadata, Invalid_args),
+		                 Dataspace_capability, Attachment_batch const &);
+		GENODE_RPC(Rpc_detach_many, void, detach_many, Local_addr_batch const &);
 
 		GENODE_RPC_INTERFACE(Rpc_attach, Rpc_detach, Rpc_add_client,
 		                     Rpc_remove_client, Rpc_fault_handler, Rpc_state,
-		                     Rpc_dataspace);
+		                     Rpc_dataspace, Rpc_attach_many, Rpc_detach_many);
 	};
 }
 
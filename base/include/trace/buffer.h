@@ -0,0 +1,131 @@
+/*
+ * \brief  Ring buffer of trace events
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__TRACE__BUFFER_H_
+#define _INCLUDE__TRACE__BUFFER_H_
+
+#include <base/stdint.h>
+#include <util/string.h>
+#include <trace/timestamp.h>
+
+namespace Genode {
+
+	namespace Trace {
+
+		struct Event
+		{
+			Timestamp     time;
+			unsigned long type;
+			unsigned long arg[2];
+		};
+
+
+		/**
+		 * Ring buffer of trace events
+		 *
+		 * The buffer is located at the begin of a dataspace, followed by the
+		 * event slots. It is written by its thread only, without locking. Once
+		 * the buffer is full, the oldest events get overwritten. Readers, which
+		 * may reside in another component that attached the dataspace, address
+		 * events by their sequence number and detect events overwritten while
+		 * being read.
+		 */
+		class Buffer
+		{
+			public:
+
+				enum { NAME_LEN = 32 };
+
+			private:
+
+				unsigned long volatile _head;      /* number of recorded events */
+				unsigned long          _capacity;  /* number of event slots     */
+				char                   _name[NAME_LEN];
+				Event                  _slots[];
+
+				static void _barrier() { __sync_synchronize(); }
+
+			public:
+
+				/**
+				 * Initialize buffer
+				 *
+				 * \param size  size of the dataspace holding the buffer
+				 * \param name  name of the thread owning the buffer
+				 */
+				void init(size_t size, char const *name)
+				{
+					_head     = 0;
+					_capacity = (size - sizeof(Buffer))/sizeof(Event);
+					strncpy(_name, name, sizeof(_name));
+				}
+
+				/**
+				 * Record event
+				 */
+				void log(Timestamp time, unsigned type, unsigned long arg0,
+				         unsigned long arg1)
+				{
+					Event &e = _slots[_head % _capacity];
+					e.time   = time;
+					e.type   = type;
+					e.arg[0] = arg0;
+					e.arg[1] = arg1;
+
+					/* publish the event after it is complete */
+					_barrier();
+					_head = _head + 1;
+				}
+
+				char const *name() const { return _name; }
+
+				/**
+				 * Return sequence number of the next event to be recorded
+				 */
+				unsigned long head() const { return _head; }
+
+				/**
+				 * Return sequence number of the oldest event still present
+				 */
+				unsigned long tail() const
+				{
+					unsigned long const head = _head;
+					return head >= _capacity ? head - _capacity + 1 : 0;
+				}
+
+				/**
+				 * Obtain copy of event
+				 *
+				 * \param seq  sequence number of event
+				 * \return     false if the event was not recorded yet or was
+				 *             overwritten
+				 *
+				 * The slot following the head is excluded because it may be
+				 * written at the same time.
+				 */
+				bool read(unsigned long seq, Event *out) const
+				{
+					if (seq >= _head || _head - seq >= _capacity)
+						return false;
+
+					*out = _slots[seq % _capacity];
+
+					/* check if the writer reused the slot meanwhile */
+					_barrier();
+					return _head - seq < _capacity;
+				}
+		};
+	}
+}
+
+#endif /* _INCLUDE__TRACE__BUFFER_H_ */
@@ -0,0 +1,149 @@
+/*
+ * \brief  Trace points
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__TRACE__EVENTS_H_
+#define _INCLUDE__TRACE__EVENTS_H_
+
+#include <base/stdint.h>
+
+namespace Genode {
+
+	namespace Trace {
+
+		/**
+		 * Types of events recorded by the built-in trace points
+		 */
+		enum Event_type {
+			RPC_CALL,         /* client issues RPC: opcode, capability      */
+			RPC_RETURNED,     /* client got reply: opcode, result           */
+			RPC_DISPATCH,     /* server received RPC: opcode, badge         */
+			RPC_REPLY,        /* server dispatched RPC: opcode, badge       */
+			SIGNAL_SUBMIT,    /* signal submitted: context capability, num  */
+			SIGNAL_RECEIVED,  /* signal received: context, num              */
+			LOCK_CONTENDED,   /* lock acquired after blocking: lock, cycles */
+			PAGE_FAULT,       /* page fault handled by core: address, IP    */
+			PACKET_SUBMIT,    /* packet submitted: offset, size             */
+			PACKET_ACK,       /* packet acknowledged: offset, size          */
+			NUM_EVENT_TYPES
+		};
+
+		/**
+		 * Groups of trace points, to be combined as argument of 'Control::enable'
+		 */
+		enum Event_group {
+			RPC         = (1 << RPC_CALL) | (1 << RPC_RETURNED)
+			            | (1 << RPC_DISPATCH) | (1 << RPC_REPLY),
+			SIGNAL      = (1 << SIGNAL_SUBMIT) | (1 << SIGNAL_RECEIVED),
+			LOCK        = (1 << LOCK_CONTENDED),
+			PAGE_FAULTS = (1 << PAGE_FAULT),
+			PACKET      = (1 << PACKET_SUBMIT) | (1 << PACKET_ACK),
+			ALL         = (1 << NUM_EVENT_TYPES) - 1
+		};
+
+		/**
+		 * Return name of event type as used in trace dumps
+		 */
+		char const *event_name(unsigned type);
+
+		class Buffer_handler;
+
+		/**
+		 * Process-global tracing policy
+		 *
+		 * Each thread records the events of enabled trace points in a trace
+		 * buffer of its own. The buffers are allocated when tracing gets armed
+		 * via 'arm'. Threads created afterwards obtain their buffer at
+		 * construction time. Events are recorded only if the thread has a
+		 * buffer and the event type is enabled.
+		 */
+		class Control
+		{
+			private:
+
+				static unsigned volatile _enabled;  /* mask of event types */
+
+			public:
+
+				/**
+				 * Return true if trace point of the given type is enabled
+				 */
+				static bool enabled(Event_type type) {
+					return _enabled & (1U << type); }
+
+				/**
+				 * Return mask of enabled event types
+				 */
+				static unsigned enabled_events() { return _enabled; }
+
+				/**
+				 * Enable the given event types, disable all others
+				 *
+				 * \param events  mask of event types, e.g., 'RPC | LOCK'
+				 */
+				static void enable(unsigned events);
+
+				/**
+				 * Allocate trace buffers for all threads
+				 *
+				 * \param buffer_size  size of the dataspace of each buffer
+				 *
+				 * Buffers already present are kept.
+				 */
+				static void arm(size_t buffer_size);
+
+				/**
+				 * Return size of trace buffers, 0 if tracing is not armed
+				 */
+				static size_t buffer_size();
+
+				/**
+				 * Call 'handler' for the trace buffer of each thread
+				 *
+				 * The buffers cannot vanish while 'for_each_buffer' is executed.
+				 */
+				static void for_each_buffer(Buffer_handler &handler);
+
+				/**
+				 * Print content of all trace buffers to the LOG
+				 *
+				 * Tracing is disabled while dumping. The output is meant to be
+				 * post-processed by 'tool/trace_dump'. Each event is printed
+				 * as a line of the form
+				 *
+				 * ! trace: <time> <event> <arg0> <arg1> <thread name>
+				 *
+				 * The thread name comes last because it may contain spaces.
+				 */
+				static void dump();
+		};
+
+		/**
+		 * Record event in the trace buffer of the calling thread
+		 */
+		void log(Event_type type, unsigned long arg0, unsigned long arg1);
+
+		/**
+		 * Trace point
+		 *
+		 * A disabled trace point costs the test of a bit of the policy only.
+		 */
+		inline void event(Event_type type, unsigned long arg0 = 0,
+		                  unsigned long arg1 = 0)
+		{
+			if (Control::enabled(type))
+				log(type, arg0, arg1);
+		}
+	}
+}
+
+#endif /* _INCLUDE__TRACE__EVENTS_H_ */
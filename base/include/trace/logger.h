@@ -0,0 +1,95 @@
+/*
+ * \brief  Per-thread recording of trace events
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__TRACE__LOGGER_H_
+#define _INCLUDE__TRACE__LOGGER_H_
+
+#include <util/list.h>
+#include <ram_session/capability.h>
+#include <trace/events.h>
+#include <trace/buffer.h>
+
+namespace Genode {
+
+	namespace Trace {
+
+		/**
+		 * Interface for inspecting the trace buffers via
+		 * 'Control::for_each_buffer'
+		 */
+		class Buffer_handler
+		{
+			public:
+
+				virtual ~Buffer_handler() { }
+
+				/**
+				 * Called for each trace buffer
+				 *
+				 * \param ds      dataspace holding the buffer, which can be
+				 *                handed out to a monitor
+				 * \param buffer  locally attached buffer
+				 */
+				virtual void handle_buffer(Ram_dataspace_capability ds,
+				                           Buffer const &buffer) = 0;
+		};
+
+
+		/**
+		 * Trace buffer of a thread
+		 */
+		class Logger : public List<Logger>::Element
+		{
+			private:
+
+				char                     _name[Buffer::NAME_LEN];
+				Ram_dataspace_capability _ds;
+				Buffer * volatile        _buffer;
+
+				friend class Control;
+
+				/**
+				 * Allocate buffer, must be called with the registry lock held
+				 */
+				void _alloc_buffer(size_t size);
+
+				/*
+				 * Noncopyable
+				 */
+				Logger(Logger const &);
+				Logger &operator = (Logger const &);
+
+			public:
+
+				/**
+				 * Constructor
+				 *
+				 * \param name  name of the thread
+				 *
+				 * If tracing is armed, the buffer is allocated right away.
+				 */
+				explicit Logger(char const *name);
+
+				~Logger();
+
+				void log(Event_type type, unsigned long arg0, unsigned long arg1)
+				{
+					Buffer * const buffer = _buffer;
+					if (buffer)
+						buffer->log(timestamp(), type, arg0, arg1);
+				}
+		};
+	}
+}
+
+#endif /* _INCLUDE__TRACE__LOGGER_H_ */
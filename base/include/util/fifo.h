@@ -145,6 +145,27 @@ namespace Genode {
 				return result;
 			}
 	};
+
+
+	/**
+	 * Helper for using member variables as FIFO elements
+	 *
+	 * \param T  type of compound object to be organized in a FIFO
+	 *
+	 * This helper allows the creation of FIFOs that use member variables to
+	 * connect their elements, analogously to 'List_element'.
+	 */
+	template <typename T>
+	class Fifo_element : public Fifo<Fifo_element<T> >::Element
+	{
+		T *_object;
+
+		public:
+
+			Fifo_element(T *object) : _object(object) { }
+
+			T *object() { return _object; }
+	};
 }
 
 #endif /* _INCLUDE__UTIL__FIFO_H_ */
@@ -0,0 +1,38 @@
+/*
+ * \brief  Trace timestamp
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__X86__TRACE__TIMESTAMP_H_
+#define _INCLUDE__X86__TRACE__TIMESTAMP_H_
+
+#include <base/stdint.h>
+
+namespace Genode {
+
+	namespace Trace {
+
+		typedef uint64_t Timestamp;
+
+		/**
+		 * Read time-stamp counter of the CPU
+		 */
+		inline Timestamp timestamp() __attribute((always_inline));
+		inline Timestamp timestamp()
+		{
+			uint32_t lo, hi;
+			__asm__ __volatile__("rdtsc" : "=a" (lo), "=d" (hi));
+			return (uint64_t)hi << 32 | lo;
+		}
+	}
+}
+
+#endif /* _INCLUDE__X86__TRACE__TIMESTAMP_H_ */
@@ -28,24 +28,28 @@ inline void *operator new(size_t, void *at) { return at; }
  **************************/
 
 Allocator_avl_base::Block *
-Allocator_avl_base::Block::find_best_fit(size_t size, unsigned align)
+Allocator_avl_base::Block::Size_node::find_best_fit(size_t min_size, size_t size,
+                                                    unsigned align,
+                                                    unsigned long &budget)
 {
-	/* find child with lowest max_avail value */
-	bool side = _child_max_avail(1) < _child_max_avail(0);
+	if (!budget)
+		return 0;
 
-	/* try to find best fitting block in both subtrees */
-	for (int i = 0; i < 2; i++, side = !side) {
+	/* blocks of the left subtree are smaller, so they are preferred */
+	if (_block->size() >= min_size) {
 
-		if (_child_max_avail(side) < size)
-			continue;
+		Block *b = child(LEFT)
+		         ? child(LEFT)->find_best_fit(min_size, size, align, budget) : 0;
+		if (b || !budget)
+			return b;
 
-		Block *res = child(side) ? child(side)->find_best_fit(size, align) : 0;
-
-		if (res)
-			return (_fits(size, align) && size < res->size()) ? this : res;
+		budget--;
+		if (_block->fits(size, align))
+			return _block;
 	}
 
-	return (_fits(size, align)) ? this : 0;
+	return child(RIGHT)
+	       ? child(RIGHT)->find_best_fit(min_size, size, align, budget) : 0;
 }
 
 
@@ -132,19 +136,29 @@ int Allocator_avl_base::_add_block(Block *block_metadata,
 	/* call constructor for new block */
 	new (block_metadata) Block(base, size, used);
 
-	/* insert block into avl tree */
+	/* insert block into avl trees */
 	_addr_tree.insert(block_metadata);
+	if (!used)
+		_size_tree.insert(block_metadata->size_node());
 
 	return 0;
 }
 
 
+void Allocator_avl_base::_remove_block(Block *b)
+{
+	/* remove block from both avl trees */
+	if (!b->used())
+		_size_tree.remove(b->size_node());
+	_addr_tree.remove(b);
+}
+
+
 void Allocator_avl_base::_destroy_block(Block *b)
 {
 	if (!b) return;
 
-	/* remove block from both avl trees */
-	_addr_tree.remove(b);
+	_remove_block(b);
 	_md_alloc->free(b, _md_entry_size);
 }
 
@@ -253,9 +267,35 @@ Range_allocator::Alloc_return Allocator_avl_base::alloc_aligned(size_t size, voi
 	if (!_alloc_two_blocks_metadata(&dst1, &dst2))
 		return Alloc_return(Alloc_return::OUT_OF_METADATA);
 
-	/* find best fitting block */
-	Block *b = _addr_tree.first();
-	b = b ? b->find_best_fit(size, align) : 0;
+	/*
+	 * Find best fitting block
+	 *
+	 * First, the few smallest blocks that can hold 'size' bytes are probed
+	 * for the alignment constraint. If none of them fits, the search takes
+	 * the smallest block that can hold 'size' plus the maximum alignment
+	 * padding, which fits regardless of its address. Both searches take
+	 * O(log n) steps. Only if no block is large enough for the padding,
+	 * all remaining candidates are checked before the allocation fails.
+	 */
+	enum { NUM_PROBED_BLOCKS = 8 };
+
+	Block::Size_node *n = _size_tree.first();
+	Block *b = 0;
+	if (n) {
+		unsigned long budget = NUM_PROBED_BLOCKS;
+		b = n->find_best_fit(size, size, align, budget);
+
+		size_t const padded_size = size + (1UL << align) - 1;
+		if (!b && padded_size >= size) {
+			budget = NUM_PROBED_BLOCKS;
+			b = n->find_best_fit(padded_size, size, align, budget);
+		}
+
+		if (!b) {
+			budget = ~0UL;
+			b = n->find_best_fit(size, size, align, budget);
+		}
+	}
 
 	if (!b) {
 		_md_alloc->free(dst1, sizeof(Block));
@@ -333,9 +373,32 @@ void Allocator_avl_base::free(void *addr)
 		PERR("%s: given address (0x%p) is not the block start address (0x%lx)",
 		     __PRETTY_FUNCTION__, addr, new_addr);
 
-	_destroy_block(b);
+	/*
+	 * The meta data of the freed block is reused for the free block that
+	 * results from merging the freed block with its free neighbours. So
+	 * freeing never depends on the allocation of meta data.
+	 */
+	_remove_block(b);
+
+	/* merge with predecessor */
+	Block *n;
+	if (new_addr != 0 && (n = _find_by_address(new_addr - 1)) && !n->used()) {
+
+		new_size += n->size();
+		new_addr  = n->addr();
+
+		_destroy_block(n);
+	}
+
+	/* merge with successor */
+	if ((n = _find_by_address(new_addr + new_size)) && !n->used()) {
+
+		new_size += n->size();
+
+		_destroy_block(n);
+	}
 
-	add_range(new_addr, new_size);
+	_add_block(b, new_addr, new_size, Block::FREE);
 }
 
 
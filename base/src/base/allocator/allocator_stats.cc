@@ -0,0 +1,298 @@
+/*
+ * \brief  Allocator wrapper that collects usage statistics
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <base/allocator_stats.h>
+#include <base/slab.h>
+#include <base/snprintf.h>
+#include <base/printf.h>
+#include <util/string.h>
+
+using namespace Genode;
+
+
+/**
+ * Lock protecting the registry of instrumented allocators
+ */
+static Lock &registry_lock()
+{
+	static Lock lock;
+	return lock;
+}
+
+
+/**
+ * Registry of all instrumented allocators
+ */
+static List<Allocator_stats> &registry()
+{
+	static List<Allocator_stats> list;
+	return list;
+}
+
+
+unsigned Allocator_stats::_size_bucket(size_t size)
+{
+	unsigned bucket = 0;
+	while (bucket < NUM_SIZE_BUCKETS - 1 && size > _bucket_limit(bucket))
+		bucket++;
+
+	return bucket;
+}
+
+
+Allocator_stats::Call_site *Allocator_stats::_call_site(addr_t ip, bool create)
+{
+	unsigned const start = (unsigned)((ip >> 2) ^ (ip >> 12)) % MAX_CALL_SITES;
+
+	for (unsigned i = 0; i < MAX_CALL_SITES; i++) {
+		Call_site &site = _sites[(start + i) % MAX_CALL_SITES];
+
+		if (site.ip == ip)
+			return &site;
+
+		if (!site.ip) {
+			if (!create)
+				return 0;
+
+			site.ip = ip;
+			return &site;
+		}
+	}
+	return 0;
+}
+
+
+void Allocator_stats::_init(char const *name)
+{
+	strncpy(_name, name, sizeof(_name));
+
+	memset(_sizes, 0, sizeof(_sizes));
+	memset(_sites, 0, sizeof(_sites));
+
+	Lock::Guard guard(registry_lock());
+	registry().insert(this);
+}
+
+
+Allocator_stats::Allocator_stats(Allocator &alloc, char const *name,
+                                 unsigned sample_interval)
+:
+	_alloc(alloc), _max_block_size(0), _sample_interval(sample_interval),
+	_sample_countdown(sample_interval),
+	_num_allocs(0), _num_frees(0), _num_failed(0), _num_unattributed(0),
+	_used(0), _peak(0)
+{
+	_init(name);
+}
+
+
+Allocator_stats::Allocator_stats(Slab &slab, char const *name,
+                                 unsigned sample_interval)
+:
+	_alloc(slab), _max_block_size(slab.slab_size()),
+	_sample_interval(sample_interval), _sample_countdown(sample_interval),
+	_num_allocs(0), _num_frees(0), _num_failed(0), _num_unattributed(0),
+	_used(0), _peak(0)
+{
+	_init(name);
+}
+
+
+Allocator_stats::~Allocator_stats()
+{
+	Lock::Guard guard(registry_lock());
+	registry().remove(this);
+}
+
+
+size_t Allocator_stats::used() const
+{
+	Lock::Guard guard(_lock);
+	return _used;
+}
+
+
+size_t Allocator_stats::peak() const
+{
+	Lock::Guard guard(_lock);
+	return _peak;
+}
+
+
+void Allocator_stats::reset_peak()
+{
+	Lock::Guard guard(_lock);
+	_peak = _used;
+}
+
+
+bool Allocator_stats::alloc(size_t size, void **out_addr)
+{
+	addr_t const caller = (addr_t)__builtin_return_address(0);
+
+	/* the block, including its header, must fit into a slab entry */
+	bool const fits = !_max_block_size
+	               || size + sizeof(Header) <= _max_block_size;
+
+	if (!fits)
+		PERR("%s: block of %zu bytes exceeds slab entry of %zu bytes",
+		     _name, size + sizeof(Header), _max_block_size);
+
+	void *addr = 0;
+	bool const ok = fits && _alloc.alloc(size + sizeof(Header), &addr);
+
+	Lock::Guard guard(_lock);
+
+	if (!ok) {
+		_num_failed++;
+		return false;
+	}
+
+	Header * const header = (Header *)addr;
+	header->size      = size;
+	header->call_site = 0;
+
+	_num_allocs++;
+	_used += size;
+	if (_used > _peak)
+		_peak = _used;
+
+	Size_bucket &bucket = _sizes[_size_bucket(size)];
+	bucket.allocs++;
+	bucket.live++;
+
+	if (_sample_interval && --_sample_countdown == 0) {
+		_sample_countdown = _sample_interval;
+
+		Call_site * const site = _call_site(caller, true);
+		if (site) {
+			site->samples++;
+			site->live += size;
+			header->call_site = caller;
+		} else
+			_num_unattributed++;
+	}
+
+	*out_addr = header + 1;
+	return true;
+}
+
+
+void Allocator_stats::free(void *addr, size_t)
+{
+	if (!addr)
+		return;
+
+	Header * const header = (Header *)addr - 1;
+	size_t   const size   = header->size;
+
+	{
+		Lock::Guard guard(_lock);
+
+		_num_frees++;
+		_used -= size;
+		_sizes[_size_bucket(size)].live--;
+
+		if (header->call_site) {
+			Call_site * const site = _call_site(header->call_site, false);
+			if (site)
+				site->live -= size;
+		}
+	}
+
+	_alloc.free(header, size + sizeof(Header));
+}
+
+
+size_t Allocator_stats::generate_xml(char *dst, size_t dst_len) const
+{
+	Lock::Guard guard(_lock);
+
+	String_console out(dst, dst_len);
+
+	out.printf("<allocator name=\"%s\" allocs=\"%lu\" frees=\"%lu\" "
+	           "failed=\"%lu\" used=\"%zu\" peak=\"%zu\">\n",
+	           _name, _num_allocs, _num_frees, _num_failed, _used, _peak);
+
+	for (unsigned i = 0; i < NUM_SIZE_BUCKETS; i++) {
+		if (!_sizes[i].allocs)
+			continue;
+
+		out.printf("\t<size max=\"%zu\" allocs=\"%lu\" live=\"%lu\"/>\n",
+		           _bucket_limit(i), _sizes[i].allocs, _sizes[i].live);
+	}
+
+	if (_sample_interval) {
+		out.printf("\t<sampling interval=\"%u\" unattributed=\"%lu\">\n",
+		           _sample_interval, _num_unattributed);
+
+		for (unsigned i = 0; i < MAX_CALL_SITES; i++) {
+			if (!_sites[i].ip)
+				continue;
+
+			out.printf("\t\t<call_site ip=\"%lx\" samples=\"%lu\" live=\"%zu\"/>\n",
+			           _sites[i].ip, _sites[i].samples, _sites[i].live);
+		}
+		out.printf("\t</sampling>\n");
+	}
+
+	out.printf("</allocator>\n");
+	return out.len();
+}
+
+
+size_t Allocator_stats::generate_xml_all(char *dst, size_t dst_len)
+{
+	Lock::Guard guard(registry_lock());
+
+	String_console out(dst, dst_len);
+	out.printf("<allocators>\n");
+	size_t len = out.len();
+
+	for (Allocator_stats *a = registry().first(); a; a = a->next())
+		len += a->generate_xml(dst + len, dst_len - len);
+
+	String_console tail(dst + len, dst_len - len);
+	tail.printf("</allocators>\n");
+	return len + tail.len();
+}
+
+
+void Allocator_stats::print_all()
+{
+	Lock::Guard guard(registry_lock());
+
+	/* the buffer is protected by the registry lock */
+	enum { BUF_SIZE = 8*1024 };
+	static char buf[BUF_SIZE];
+
+	printf("<allocators>\n");
+
+	for (Allocator_stats *a = registry().first(); a; a = a->next()) {
+		a->generate_xml(buf, sizeof(buf));
+
+		/* print line by line to stay within the limits of the LOG */
+		for (char *line = buf; *line; ) {
+			char *end = line;
+			while (*end && *end != '\n')
+				end++;
+
+			char const c = *end;
+			*end = 0;
+			printf("%s\n", line);
+			line = c ? end + 1 : end;
+		}
+	}
+
+	printf("</allocators>\n");
+}
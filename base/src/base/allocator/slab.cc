@@ -31,10 +31,17 @@ void Slab_block::slab(Slab *slab)
 {
 	_slab  = slab;
 	_avail = _slab->num_elem();
+	_free  = 0;
 	next   = prev = 0;
 
-	for (unsigned i = 0; i < _avail; i++)
-		state(i, FREE);
+	/* chain entries such that the first entry is allocated first */
+	for (unsigned i = _avail; i > 0; i--) {
+		state(i - 1, FREE);
+
+		Slab_entry *e = slab_entry(i - 1);
+		e->_next_free = _free;
+		_free = e;
+	}
 }
 
 
@@ -56,15 +63,15 @@ int Slab_block::slab_entry_idx(Slab_entry *e) {
 
 void *Slab_block::alloc()
 {
-	size_t num_elem = _slab->num_elem();
-	for (unsigned i = 0; i < num_elem; i++)
-		if (state(i) == FREE) {
-			state(i, USED);
-			Slab_entry *e = slab_entry(i);
-			e->occupy(this);
-			return e->addr();
-		}
-	return 0;
+	Slab_entry *e = _free;
+	if (!e)
+		return 0;
+
+	_free = e->_next_free;
+
+	state(slab_entry_idx(e), USED);
+	e->occupy(this);
+	return e->addr();
 }
 
 
@@ -81,43 +88,23 @@ Slab_entry *Slab_block::first_used_entry()
 void Slab_block::inc_avail(Slab_entry *e)
 {
 	/* mark slab entry as free */
-	int idx = slab_entry_idx(e);
-	state(idx, FREE);
-	_avail++;
-
-	/* search previous block with higher avail value than this' */
-	Slab_block *at = prev;
+	state(slab_entry_idx(e), FREE);
 
-	while (at && (at->avail() < _avail))
-		at = at->prev;
+	e->_next_free = _free;
+	_free = e;
 
-	/*
-	 * If we already are the first block or our avail value is lower than the
-	 * previous block, do not reposition the block in the list.
-	 */
-	if (prev == 0 || at == prev)
-		return;
+	_avail++;
+	_slab->_avail_changed(this, _avail - 1);
 
-	/* reposition block in list after block with higher avail value */
-	_slab->remove_sb(this);
-	_slab->insert_sb(this, at);
+	/* the block may get released, so it must not be accessed hereafter */
+	_slab->_release_empty_block();
 }
 
 
 void Slab_block::dec_avail()
 {
 	_avail--;
-
-	/* search subsequent block with lower avail value than this' */
-	Slab_block *at = this;
-
-	while (at->next && at->next->avail() > _avail)
-		at = at->next;
-
-	if (at == this) return;
-
-	_slab->remove_sb(this);
-	_slab->insert_sb(this, at);
+	_slab->_avail_changed(this, _avail + 1);
 }
 
 
@@ -129,11 +116,16 @@ Slab::Slab(size_t slab_size, size_t block_size, Slab_block *initial_sb,
                                                 Allocator *backing_store)
 : _slab_size(slab_size),
   _block_size(block_size),
-  _first_sb(initial_sb),
+  _num_free(0),
+  _num_blocks(0),
   _initial_sb(initial_sb),
   _alloc_state(false),
+  _release_empty(false),
   _backing_store(backing_store)
 {
+	for (unsigned i = 0; i < NUM_BUCKETS; i++)
+		_blocks[i] = 0;
+
 	/*
 	 * Calculate number of entries per slab block.
 	 *
@@ -144,29 +136,32 @@ Slab::Slab(size_t slab_size, size_t block_size, Slab_block *initial_sb,
 	          / (entry_size() + 1);
 
 	/* if no initial slab block was specified, try to get one */
-	if (!_first_sb && _backing_store)
-		_first_sb = _new_slab_block();
+	Slab_block *first_sb = _initial_sb;
+	if (!first_sb && _backing_store)
+		first_sb = _new_slab_block();
 
 	/* init first slab block */
-	if (_first_sb)
-		_first_sb->slab(this);
+	if (first_sb) {
+		first_sb->slab(this);
+		_add_sb(first_sb);
+	}
 }
 
 
 Slab::~Slab()
 {
 	/* free backing store */
-	while (_first_sb) {
-		Slab_block *sb = _first_sb;
-		remove_sb(_first_sb);
-
-		/*
-		 * Only free slab blocks that we allocated. This is not the case for
-		 * the '_initial_sb' that we got as constructor argument.
-		 */
-		if (_backing_store && (sb != _initial_sb))
-			_backing_store->free(sb, _block_size);
-	}
+	for (unsigned i = 0; i < NUM_BUCKETS; i++)
+		while (Slab_block *sb = _blocks[i]) {
+			_remove_sb(sb, (Bucket)i);
+
+			/*
+			 * Only free slab blocks that we allocated. This is not the case
+			 * for the '_initial_sb' that we got as constructor argument.
+			 */
+			if (_backing_store && (sb != _initial_sb))
+				_backing_store->free(sb, _block_size);
+		}
 }
 
 
@@ -181,7 +176,20 @@ Slab_block *Slab::_new_slab_block()
 }
 
 
-void Slab::remove_sb(Slab_block *sb)
+void Slab::_insert_sb(Slab_block *sb)
+{
+	Slab_block *&first = _blocks[_bucket(sb->avail())];
+
+	sb->prev = 0;
+	sb->next = first;
+	if (first)
+		first->prev = sb;
+
+	first = sb;
+}
+
+
+void Slab::_remove_sb(Slab_block *sb, Bucket bucket)
 {
 	Slab_block *prev = sb->prev;
 	Slab_block *next = sb->next;
@@ -189,48 +197,74 @@ void Slab::remove_sb(Slab_block *sb)
 	if (prev) prev->next = next;
 	if (next) next->prev = prev;
 
-	if (_first_sb == sb)
-		_first_sb =  next;
+	if (_blocks[bucket] == sb)
+		_blocks[bucket] = next;
 
 	sb->prev = sb->next = 0;
 }
 
 
-void Slab::insert_sb(Slab_block *sb, Slab_block *at)
+void Slab::_add_sb(Slab_block *sb)
 {
-	/* determine next-pointer where to assign the current sb */
-	Slab_block **nextptr_to_sb = at ? &at->next : &_first_sb;
+	_insert_sb(sb);
+	_num_blocks++;
+	_num_free += sb->avail();
+}
 
-	/* insert current sb */
-	sb->next = *nextptr_to_sb;
-	*nextptr_to_sb = sb;
 
-	/* update prev-pointer or succeeding block */
-	if (sb->next)
-		sb->next->prev = sb;
+void Slab::_avail_changed(Slab_block *sb, size_t old_avail)
+{
+	_num_free = _num_free + sb->avail() - old_avail;
 
-	sb->prev = at;
+	Bucket const old_bucket = _bucket(old_avail);
+	if (old_bucket == _bucket(sb->avail()))
+		return;
+
+	_remove_sb(sb, old_bucket);
+	_insert_sb(sb);
 }
 
 
-bool Slab::num_free_entries_higher_than(int n)
+void Slab::_release_empty_block()
 {
-	int cnt = 0;
+	/* do not interfere with the allocation of a block */
+	if (!_release_empty || !_backing_store || _alloc_state)
+		return;
 
-	for (Slab_block *b = _first_sb; b && b->avail() > 0; b = b->next) {
-		cnt += b->avail();
-		if (cnt > n)
-			return true;
-	}
-	return false;
+	/*
+	 * Keep one empty block to avoid allocating and releasing a block
+	 * repeatedly when the number of used entries oscillates. The initial
+	 * block was not allocated from the backing store.
+	 */
+	Slab_block *sb = _blocks[EMPTY];
+	if (!sb || !sb->next)
+		return;
+
+	if (sb == _initial_sb)
+		sb = sb->next;
+
+	_remove_sb(sb, EMPTY);
+	_num_blocks--;
+	_num_free -= sb->avail();
+
+	/*
+	 * The backing store may free entries of this slab while releasing the
+	 * block. Those must not trigger a nested release.
+	 */
+	_alloc_state = true;
+	_backing_store->free(sb, _block_size);
+	_alloc_state = false;
 }
 
 
-bool Slab::alloc(size_t size, void **out_addr)
+bool Slab::num_free_entries_higher_than(int n)
 {
-	/* sanity check if first slab block is gone */
-	if (!_first_sb) return false;
+	return n < 0 || _num_free > (size_t)n;
+}
+
 
+bool Slab::alloc(size_t size, void **out_addr)
+{
 	/*
 	 * If we run out of slab, we need to allocate a new slab block. For the
 	 * special case that this block is allocated using the allocator that by
@@ -248,15 +282,17 @@ bool Slab::alloc(size_t size, void **out_addr)
 
 		if (!sb) return false;
 
-		/*
-		 * The new block has the maximum number of available slots and
-		 * so we can insert it at the beginning of the sorted block
-		 * list.
-		 */
-		insert_sb(sb);
+		_add_sb(sb);
 	}
 
-	*out_addr = _first_sb->alloc();
+	/*
+	 * Prefer partially used blocks over empty blocks to keep the number of
+	 * blocks in use low.
+	 */
+	Slab_block *sb = _blocks[PARTIAL] ? _blocks[PARTIAL] : _blocks[EMPTY];
+	if (!sb) return false;
+
+	*out_addr = sb->alloc();
 	return *out_addr == 0 ? false : true;
 }
 
@@ -271,26 +307,21 @@ void Slab::free(void *addr)
 
 void *Slab::first_used_elem()
 {
-	for (Slab_block *b = _first_sb; b; b = b->next) {
+	/* completely free slab blocks are kept in the 'EMPTY' list */
+	Bucket const buckets[] = { PARTIAL, FULL };
 
-		/* skip completely free slab blocks */
-		if (b->avail() == _num_elem)
-			continue;
+	for (unsigned i = 0; i < sizeof(buckets)/sizeof(buckets[0]); i++)
+		for (Slab_block *b = _blocks[buckets[i]]; b; b = b->next) {
 
-		/* found a block with used elements - return address of the first one */
-		Slab_entry *e = b->first_used_entry();
-		if (e) return e->addr();
-	}
+			/* found a block with used elements - return address of the first one */
+			Slab_entry *e = b->first_used_entry();
+			if (e) return e->addr();
+		}
 	return 0;
 }
 
 
 size_t Slab::consumed()
 {
-	/* count number of slab blocks */
-	unsigned sb_cnt = 0;
-	for (Slab_block *sb = _first_sb; sb; sb = sb->next)
-		sb_cnt++;
-
-	return sb_cnt * _block_size;
+	return _num_blocks * _block_size;
 }
@@ -47,7 +47,8 @@ namespace Genode {
 				                  size_t size = 0, off_t offset = 0,
 				                  bool use_local_addr = false,
 				                  Local_addr local_addr = (addr_t)0,
-				                  bool executable = false) {
+				                  bool executable = false,
+				                  bool populate = false) {
 
 					bool try_again = false;
 					do {
@@ -55,7 +56,7 @@ namespace Genode {
 							return Rm_session_client::attach(ds, size, offset,
 							                                 use_local_addr,
 							                                 local_addr,
-							                                 executable);
+							                                 executable, populate);
 
 						} catch (Rm_session::Out_of_metadata) {
 
@@ -72,6 +73,29 @@ namespace Genode {
 					return (addr_t)0;
 				}
 
+				Local_addr_batch attach_many(Dataspace_capability ds,
+				                             Attachment_batch const &batch)
+				{
+					bool try_again = false;
+					do {
+						try {
+							return Rm_session_client::attach_many(ds, batch);
+
+						} catch (Rm_session::Out_of_metadata) {
+
+							/* give up if the error occurred a second time */
+							if (try_again)
+								break;
+
+							PINF("upgrading quota donation for Env::RM session");
+							env()->parent()->upgrade(_cap, "ram_quota=8K");
+							try_again = true;
+						}
+					} while (try_again);
+
+					return Local_addr_batch();
+				}
+
 				Pager_capability add_client(Thread_capability thread)
 				{
 					bool try_again = false;
@@ -26,16 +26,17 @@ Heap::Dataspace_pool::~Dataspace_pool()
 	for (Dataspace *ds; (ds = first()); ) {
 
 		/*
-		 * read dataspace capability and modify _ds_list before detaching
-		 * possible backing store for Dataspace - we rely on LIFO list
-		 * manipulation here!
+		 * read dataspace capability and local address before detaching
+		 * the dataspace, which contains the 'Dataspace' object itself
 		 */
 
 		Ram_dataspace_capability ds_cap = ds->cap;
+		void *ds_local_addr = ds->local_addr;
 
 		remove(ds);
+		_tree.remove(ds);
 		delete ds;
-		_rm_session->detach(ds->local_addr);
+		_rm_session->detach(ds_local_addr);
 		_ram_session->free(ds_cap);
 	}
 }
@@ -44,7 +45,7 @@ Heap::Dataspace_pool::~Dataspace_pool()
 int Heap::Dataspace_pool::expand(size_t size, Range_allocator *alloc)
 {
 	Ram_dataspace_capability new_ds_cap;
-	void *local_addr, *ds_addr = 0;
+	void *local_addr;
 
 	/* make new ram dataspace available at our local address space */
 	try {
@@ -57,36 +58,234 @@ int Heap::Dataspace_pool::expand(size_t size, Range_allocator *alloc)
 		return -3;
 	}
 
-	/* add new local address range to our local allocator */
-	alloc->add_range((addr_t)local_addr, size);
+	/* place dataspace information at the beginning of the dataspace */
+	Dataspace *ds = new (local_addr) Dataspace(new_ds_cap, local_addr, size);
 
-	/* now that we have new backing store, allocate Dataspace structure */
-	if (alloc->alloc_aligned(sizeof(Dataspace), &ds_addr, 2).is_error()) {
-		PWRN("could not allocate meta data - this should never happen");
-		return -1;
-	}
+	/* add remaining local address range to our local allocator */
+	alloc->add_range(ds->range_base(), ds->range_size());
 
 	/* add dataspace information to list of dataspaces */
-	Dataspace *ds  = new (ds_addr) Dataspace(new_ds_cap, local_addr);
 	insert(ds);
+	_tree.insert(ds);
 
 	return 0;
 }
 
 
+bool Heap::Dataspace_pool::release(Dataspace *ds, Range_allocator *alloc)
+{
+	if (alloc->remove_range(ds->range_base(), ds->range_size()))
+		return false;
+
+	Ram_dataspace_capability ds_cap = ds->cap;
+	void *ds_local_addr = ds->local_addr;
+
+	remove(ds);
+	_tree.remove(ds);
+	delete ds;
+	_rm_session->detach(ds_local_addr);
+	_ram_session->free(ds_cap);
+	return true;
+}
+
+
 int Heap::quota_limit(size_t new_quota_limit)
 {
-	if (new_quota_limit < _quota_used) return -1;
+	if (new_quota_limit < _quota_used + _md_alloc.consumed()) return -1;
 	_quota_limit = new_quota_limit;
 	return 0;
 }
 
 
+Heap::Md_alloc::~Md_alloc()
+{
+	while (Chunk *chunk = _chunks.first())
+		_release(chunk);
+}
+
+
+Heap::Md_alloc::Chunk *Heap::Md_alloc::_new_chunk()
+{
+	size_t const size = _chunk_size;
+
+	if (_quota_used + _consumed + size > _quota_limit)
+		return 0;
+
+	Ram_dataspace_capability ds_cap;
+	void *local_addr;
+
+	try {
+		ds_cap     = _ram_session->alloc(size);
+		local_addr = _rm_session->attach(ds_cap);
+	} catch (Ram_session::Alloc_failed) {
+		return 0;
+	} catch (Rm_session::Attach_failed) {
+		_ram_session->free(ds_cap);
+		return 0;
+	}
+
+	/* the chunk header is followed by the slots */
+	Chunk *chunk = new (local_addr) Chunk(ds_cap, size);
+
+	addr_t const first = align_addr((addr_t)local_addr + sizeof(Chunk), 4);
+	for (addr_t a = first; a + SLOT_SIZE <= (addr_t)local_addr + size; a += SLOT_SIZE) {
+		Slot *slot = (Slot *)a;
+		slot->next  = chunk->free;
+		chunk->free = slot;
+		chunk->num_slots++;
+	}
+
+	_chunks.insert(chunk);
+	_avail.insert(chunk);
+	_num_empty++;
+	_num_free += chunk->num_slots;
+	_consumed += size;
+
+	/* exponentially increase the chunk size with each allocated chunk */
+	_chunk_size = min(2*_chunk_size, (size_t)MAX_CHUNK_SIZE);
+
+	return chunk;
+}
+
+
+void Heap::Md_alloc::_release(Chunk *chunk)
+{
+	Ram_dataspace_capability ds_cap = chunk->cap;
+
+	if (chunk->num_used == 0)
+		_num_empty--;
+
+	if (chunk->free)
+		_avail.remove(chunk);
+
+	_chunks.remove(chunk);
+	_num_free -= chunk->num_slots - chunk->num_used;
+	_consumed -= chunk->size;
+
+	delete chunk;
+	_rm_session->detach(chunk);
+	_ram_session->free(ds_cap);
+}
+
+
+bool Heap::Md_alloc::alloc(size_t size, void **out_addr)
+{
+	if (size > SLOT_SIZE)
+		return false;
+
+	Chunk *chunk = _avail.first();
+	if (!chunk && !(chunk = _new_chunk()))
+		return false;
+
+	if (chunk->num_used++ == 0)
+		_num_empty--;
+
+	Slot *slot  = chunk->free;
+	chunk->free = slot->next;
+	_num_free--;
+
+	if (!chunk->free)
+		_avail.remove(chunk);
+
+	*out_addr = slot;
+	return true;
+}
+
+
+bool Heap::Md_alloc::replenish()
+{
+	while (_num_free < _num_reserved)
+		if (!_new_chunk())
+			return false;
+
+	return true;
+}
+
+
+bool Heap::Md_alloc::reserve()
+{
+	_num_reserved++;
+
+	if (replenish())
+		return true;
+
+	_num_reserved--;
+	return false;
+}
+
+
+void Heap::Md_alloc::release_empty_chunks()
+{
+	Chunk *next = 0;
+	for (Chunk *chunk = _avail.first(); chunk && _num_empty > 1; chunk = next) {
+
+		next = chunk->next();
+
+		if (chunk->num_used == 0 && _num_free - chunk->num_slots >= _num_reserved)
+			_release(chunk);
+	}
+}
+
+
+void Heap::Md_alloc::free(void *addr, size_t)
+{
+	Chunk *chunk = _chunks.first();
+	chunk = chunk ? chunk->find_by_addr((addr_t)addr) : 0;
+
+	if (!chunk) {
+		PWRN("attempt to free unknown meta-data slot");
+		return;
+	}
+
+	if (!chunk->free)
+		_avail.insert(chunk);
+
+	Slot *slot  = (Slot *)addr;
+	slot->next  = chunk->free;
+	chunk->free = slot;
+	_num_free++;
+
+	if (--chunk->num_used == 0)
+		_num_empty++;
+}
+
+
+void Heap::unused_limit(size_t limit)
+{
+	Lock::Guard lock_guard(_lock);
+
+	_unused_limit = limit;
+	_release_unused();
+	_md_alloc.release_empty_chunks();
+}
+
+
+void Heap::_release_unused()
+{
+	Dataspace *next = 0;
+	for (Dataspace *ds = _ds_pool.first(); ds && _unused_size > _unused_limit; ds = next) {
+
+		next = ds->next();
+
+		size_t const size = ds->size;
+		if (ds->num_blocks == 0 && _ds_pool.release(ds, &_alloc)) {
+			_unused_size -= size;
+			_md_alloc.unreserve();
+		}
+	}
+}
+
+
 bool Heap::_try_local_alloc(size_t size, void **out_addr)
 {
 	if (_alloc.alloc_aligned(size, out_addr, 2).is_error())
 		return false;
 
+	/* account block at the dataspace that contains it */
+	Dataspace *ds = _ds_pool.lookup((addr_t)*out_addr);
+	if (ds && ds->num_blocks++ == 0)
+		_unused_size -= ds->size;
+
 	_quota_used += size;
 	return true;
 }
@@ -98,12 +297,14 @@ bool Heap::alloc(size_t size, void **out_addr)
 	Lock::Guard lock_guard(_lock);
 
 	/* check requested allocation against quota limit */
-	if (size + _quota_used > _quota_limit)
+	if (size + _quota_used + _md_alloc.consumed() > _quota_limit)
 		return false;
 
 	/* try allocation at our local allocator */
-	if (_try_local_alloc(size, out_addr))
+	if (_try_local_alloc(size, out_addr)) {
+		_md_alloc.replenish();
 		return true;
+	}
 
 	/*
 	 * Calculate block size of needed backing store. The block must hold the
@@ -122,13 +323,27 @@ bool Heap::alloc(size_t size, void **out_addr)
 		_chunk_size = min(2*_chunk_size, (size_t)MAX_CHUNK_SIZE);
 	}
 
-	if (_ds_pool.expand(align_addr(request_size, 12), &_alloc) < 0) {
+	request_size = align_addr(request_size, 12);
+
+	/* reserve the meta data needed for releasing the dataspace later on */
+	if (!_md_alloc.reserve())
+		return false;
+
+	if (_ds_pool.expand(request_size, &_alloc) < 0) {
+		_md_alloc.unreserve();
 		PWRN("could not expand dataspace pool");
 		return 0;
 	}
 
+	/* the new dataspace stays unused until the allocation below */
+	_unused_size += request_size;
+
 	/* allocate originally requested block */
-	return _try_local_alloc(size, out_addr);
+	if (!_try_local_alloc(size, out_addr))
+		return false;
+
+	_md_alloc.replenish();
+	return true;
 }
 
 
@@ -142,8 +357,13 @@ void Heap::free(void *addr, size_t size)
 
 	_quota_used -= size;
 
-	/*
-	 * We could check for completely unused dataspaces...
-	 * Yes, we could...
-	 */
+	/* return dataspaces that are no longer used to the RAM session */
+	Dataspace *ds = _ds_pool.lookup((addr_t)addr);
+	if (ds && --ds->num_blocks == 0) {
+		_unused_size += ds->size;
+		_release_unused();
+	}
+
+	/* the local allocator is done with its meta data at this point */
+	_md_alloc.release_empty_chunks();
 }
@@ -0,0 +1,393 @@
+/*
+ * \brief  Heap with per-thread caches for small blocks
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <base/heap.h>
+#include <base/thread.h>
+
+using namespace Genode;
+
+
+/**
+ * Lock protecting the registry of thread-cached heaps
+ */
+static Lock &registry_lock()
+{
+	static Lock lock;
+	return lock;
+}
+
+
+/**
+ * Registry of all thread-cached heaps, used for releasing the caches of
+ * destructed threads
+ */
+static List<Thread_cached_heap> &registry()
+{
+	static List<Thread_cached_heap> list;
+	return list;
+}
+
+
+/**
+ * Return slot of the cache table where the lookup for a thread starts
+ */
+static unsigned cache_slot(Thread_base *thread)
+{
+	addr_t const a = (addr_t)thread;
+	return (unsigned)((a >> 4) ^ (a >> 12) ^ (a >> 20))
+	       % Thread_cached_heap::MAX_THREADS;
+}
+
+
+int Thread_cached_heap::_size_class(size_t block_size)
+{
+	for (int i = 0; i < NUM_CLASSES; i++)
+		if (block_size <= _class_size(i))
+			return i;
+
+	return -1;
+}
+
+
+size_t Thread_cached_heap::_class_size(int size_class)
+{
+	static size_t const sizes[NUM_CLASSES] = {
+		32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048 };
+
+	return sizes[size_class];
+}
+
+
+Thread_cached_heap::Thread_cache *Thread_cached_heap::_thread_cache()
+{
+	Thread_base * const myself = Thread_base::myself();
+
+	/* the main thread uses the backing heap directly */
+	if (!myself)
+		return 0;
+
+	unsigned const start = cache_slot(myself);
+
+	for (unsigned i = 0; i < MAX_THREADS; i++) {
+		Thread_cache * const cache = _caches[(start + i) % MAX_THREADS];
+		if (!cache)
+			break;
+		if (cache->owner == myself)
+			return cache;
+	}
+
+	return _claim_thread_cache(myself, start);
+}
+
+
+Thread_cached_heap::Thread_cache *
+Thread_cached_heap::_claim_thread_cache(Thread_base *myself, unsigned start)
+{
+	Lock::Guard guard(_caches_lock);
+
+	for (unsigned i = 0; i < MAX_THREADS; i++) {
+
+		unsigned const slot  = (start + i) % MAX_THREADS;
+		Thread_cache  *cache = _caches[slot];
+
+		/* reuse cache left behind by a destructed thread */
+		if (cache && !cache->owner) {
+			cache->owner = myself;
+			return cache;
+		}
+
+		if (cache)
+			continue;
+
+		try { cache = new (&_heap) Thread_cache(); }
+		catch (Allocator::Out_of_memory) { return 0; }
+
+		cache->owner = myself;
+
+		/*
+		 * Make the initialized cache visible to the lock-free lookup in
+		 * '_thread_cache'. The barrier orders the initialization before
+		 * the publication of the pointer on weakly ordered CPUs. Once
+		 * published, a slot is never cleared while the heap exists.
+		 */
+		__sync_synchronize();
+		_caches[slot] = cache;
+		return cache;
+	}
+
+	/* all slots are in use, fall back to the backing heap */
+	return 0;
+}
+
+
+Thread_cached_heap::Block *Thread_cached_heap::_alloc_block(size_t block_size)
+{
+	void *addr = 0;
+	if (!_heap.alloc(block_size, &addr)) {
+
+		/* make the magazines of the depot available and retry */
+		{
+			Lock::Guard guard(_lock);
+			_drain_depot();
+		}
+
+		if (!_heap.alloc(block_size, &addr))
+			return 0;
+	}
+
+	{
+		Lock::Guard guard(_lock);
+		_used += block_size;
+	}
+
+	Block *block = (Block *)addr;
+	block->size = block_size;
+	return block;
+}
+
+
+void Thread_cached_heap::_free_block(Block *block)
+{
+	Lock::Guard guard(_lock);
+
+	_used -= block->size;
+	_heap.free(block, block->size);
+}
+
+
+void Thread_cached_heap::_release_magazine(Magazine &magazine)
+{
+	while (!magazine.empty()) {
+		Block *block = magazine.pop();
+		_used -= block->size;
+		_heap.free(block, block->size);
+	}
+}
+
+
+void Thread_cached_heap::_deposit(int size_class, Magazine &magazine)
+{
+	Lock::Guard guard(_lock);
+
+	if (_depot_count[size_class] < DEPOT_SIZE) {
+		magazine.head->next_magazine = _depot[size_class];
+		_depot[size_class] = magazine.head;
+		_depot_count[size_class]++;
+		magazine = Magazine();
+	} else
+		_release_magazine(magazine);
+}
+
+
+bool Thread_cached_heap::_withdraw(int size_class, Magazine &magazine)
+{
+	Lock::Guard guard(_lock);
+
+	Block * const head = _depot[size_class];
+	if (!head)
+		return false;
+
+	_depot[size_class] = head->next_magazine;
+	_depot_count[size_class]--;
+
+	magazine.head  = head;
+	magazine.count = MAGAZINE_SIZE;
+	return true;
+}
+
+
+void Thread_cached_heap::_drain_depot()
+{
+	for (int i = 0; i < NUM_CLASSES; i++) {
+		while (_depot[i]) {
+			Magazine magazine;
+			magazine.head  = _depot[i];
+			magazine.count = MAGAZINE_SIZE;
+			_depot[i] = magazine.head->next_magazine;
+			_release_magazine(magazine);
+		}
+		_depot_count[i] = 0;
+	}
+}
+
+
+void Thread_cached_heap::_flush(Thread_cache &cache)
+{
+	for (int i = 0; i < NUM_CLASSES; i++) {
+		Magazine *magazines[] = { &cache.loaded[i], &cache.previous[i] };
+		for (unsigned j = 0; j < sizeof(magazines)/sizeof(magazines[0]); j++) {
+
+			Magazine &magazine = *magazines[j];
+
+			if (magazine.full()) {
+				_deposit(i, magazine);
+			} else {
+				Lock::Guard guard(_lock);
+				_release_magazine(magazine);
+			}
+		}
+	}
+}
+
+
+void Thread_cached_heap::_release_thread_cache(Thread_base *thread)
+{
+	Lock::Guard guard(_caches_lock);
+
+	for (unsigned i = 0; i < MAX_THREADS; i++) {
+		Thread_cache * const cache = _caches[i];
+		if (cache && cache->owner == thread) {
+			_flush(*cache);
+			cache->owner = 0;
+			return;
+		}
+	}
+}
+
+
+void Thread_cached_heap::release_thread_caches(Thread_base *thread)
+{
+	Lock::Guard guard(registry_lock());
+
+	for (Thread_cached_heap *h = registry().first(); h; h = h->next())
+		h->_release_thread_cache(thread);
+}
+
+
+Thread_cached_heap::Thread_cached_heap(Allocator &heap)
+:
+	_heap(heap), _used(0)
+{
+	for (unsigned i = 0; i < MAX_THREADS; i++)
+		_caches[i] = 0;
+
+	for (int i = 0; i < NUM_CLASSES; i++) {
+		_depot[i]       = 0;
+		_depot_count[i] = 0;
+	}
+
+	Lock::Guard guard(registry_lock());
+	registry().insert(this);
+}
+
+
+Thread_cached_heap::~Thread_cached_heap()
+{
+	{
+		Lock::Guard guard(registry_lock());
+		registry().remove(this);
+	}
+
+	for (unsigned i = 0; i < MAX_THREADS; i++) {
+		Thread_cache * const cache = _caches[i];
+		if (!cache)
+			continue;
+
+		_flush(*cache);
+		_caches[i] = 0;
+		destroy(&_heap, cache);
+	}
+
+	Lock::Guard guard(_lock);
+	_drain_depot();
+}
+
+
+bool Thread_cached_heap::alloc(size_t size, void **out_addr)
+{
+	size_t     block_size = size + sizeof(size_t);
+	int const  size_class = _size_class(block_size);
+	Block     *block      = 0;
+
+	if (size_class >= 0) {
+
+		/* round up to the size class to make the block cacheable */
+		block_size = _class_size(size_class);
+
+		Thread_cache * const cache = _thread_cache();
+		if (cache) {
+			Magazine &loaded   = cache->loaded[size_class];
+			Magazine &previous = cache->previous[size_class];
+
+			if (loaded.empty()) {
+				if (!previous.empty()) {
+					Magazine const tmp = loaded;
+					loaded   = previous;
+					previous = tmp;
+				} else {
+					_withdraw(size_class, loaded);
+				}
+			}
+
+			if (!loaded.empty())
+				block = loaded.pop();
+		}
+	}
+
+	if (!block)
+		block = _alloc_block(block_size);
+
+	if (!block)
+		return false;
+
+	*out_addr = (void *)((addr_t)block + sizeof(size_t));
+	return true;
+}
+
+
+void Thread_cached_heap::free(void *addr, size_t)
+{
+	if (!addr)
+		return;
+
+	Block * const block      = (Block *)((addr_t)addr - sizeof(size_t));
+	int     const size_class = _size_class(block->size);
+
+	Thread_cache * const cache = (size_class >= 0) ? _thread_cache() : 0;
+	if (!cache) {
+		_free_block(block);
+		return;
+	}
+
+	Magazine &loaded   = cache->loaded[size_class];
+	Magazine &previous = cache->previous[size_class];
+
+	if (loaded.full()) {
+
+		/* hand the previous magazine over to the depot if it is full */
+		if (previous.full())
+			_deposit(size_class, previous);
+
+		Magazine const tmp = loaded;
+		loaded   = previous;
+		previous = tmp;
+	}
+
+	loaded.push(block);
+}
+
+
+size_t Thread_cached_heap::consumed()
+{
+	Lock::Guard guard(_lock);
+
+	/*
+	 * The magazines of the threads can be accessed by their owners only.
+	 * Hence, their blocks are accounted as consumed. The depot, however,
+	 * is protected by '_lock' and returned to the backing heap so that it
+	 * does not inflate the result.
+	 */
+	_drain_depot();
+
+	return _used;
+}
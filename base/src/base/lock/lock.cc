@@ -16,6 +16,7 @@
 
 /* local includes */
 #include "spin_lock.h"
+#include "lock_trace.h"
 
 using namespace Genode;
 
@@ -93,6 +94,8 @@ void Cancelable_lock::lock()
 	_last_applicant = &myself;
 	spinlock_unlock(&_spinlock_state);
 
+	Trace::Timestamp const blocked = lock_contention_start();
+
 	/*
 	 * At this point, a race can happen. We have added ourself to the wait
 	 * queue but do not block yet. If we get preempted here, the lock holder
@@ -138,6 +141,8 @@ void Cancelable_lock::lock()
 		throw Blocking_canceled();
 	}
 	spinlock_unlock(&_spinlock_state);
+
+	lock_contention_end(this, blocked);
 }
 
 
@@ -0,0 +1,46 @@
+/*
+ * \brief  Trace point for lock contention
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LOCK_TRACE_H_
+#define _LOCK_TRACE_H_
+
+/* Genode includes */
+#include <trace/events.h>
+#include <trace/timestamp.h>
+
+
+/**
+ * Return start of blocking if lock contention is traced, otherwise 0
+ */
+static inline Genode::Trace::Timestamp lock_contention_start()
+{
+	using namespace Genode::Trace;
+
+	return Control::enabled(LOCK_CONTENDED) ? timestamp() : 0;
+}
+
+
+/**
+ * Record acquisition of contended lock
+ *
+ * \param start  result of 'lock_contention_start'
+ */
+static inline void lock_contention_end(void *lock, Genode::Trace::Timestamp start)
+{
+	using namespace Genode::Trace;
+
+	if (start)
+		event(LOCK_CONTENDED, (Genode::addr_t)lock, timestamp() - start);
+}
+
+#endif /* _LOCK_TRACE_H_ */
@@ -21,7 +21,7 @@ using namespace Genode;
 void Rpc_entrypoint::_dissolve(Rpc_object_base *obj)
 {
 	/* make sure nobody is able to find this object */
-	remove_locked(obj);
+	_pool.remove_locked(obj);
 
 	/*
 	 * The activation may execute a blocking operation in a dispatch function.
@@ -98,10 +98,12 @@ bool Rpc_entrypoint::is_myself() const
 
 
 Rpc_entrypoint::Rpc_entrypoint(Cap_session *cap_session, size_t stack_size,
-                               char const *name, bool start_on_construction)
+                               char const *name, bool start_on_construction,
+                               Object_pool<Rpc_object_base> *pool)
 :
 	Thread_base(name, stack_size),
 	_cap(Untyped_capability()),
+	_pool(pool ? *pool : *this),
 	_curr_obj(0), _cap_valid(Lock::LOCKED), _delay_start(Lock::LOCKED),
 	_delay_exit(Lock::LOCKED),
 	_cap_session(cap_session)
@@ -125,7 +127,8 @@ Rpc_entrypoint::~Rpc_entrypoint()
 
 	dissolve(&_exit_handler);
 
-	if (Pool::first()) {
+	/* objects of a shared pool are dissolved by the owner of the pool */
+	if (&_pool == this && Pool::first()) {
 		PWRN("Object pool not empty in %s", __func__);
 
 		/* dissolve all objects - objects are not destroyed! */
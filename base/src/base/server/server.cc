@@ -17,6 +17,7 @@
 
 /* Genode includes */
 #include <base/rpc_server.h>
+#include <trace/events.h>
 #include <base/sleep.h>
 
 using namespace Genode;
@@ -33,7 +34,7 @@ Untyped_capability Rpc_entrypoint::_manage(Rpc_object_base *obj)
 
 	/* add server object to object pool */
 	obj->cap(new_obj_cap);
-	insert(obj);
+	_pool.insert(obj);
 
 	/* return capability that uses the object id as badge */
 	return new_obj_cap;
@@ -66,7 +67,7 @@ void Rpc_entrypoint::entry()
 		srv.ret(ERR_INVALID_OBJECT);
 
 		/* atomically lookup and lock referenced object */
-		Object_pool<Rpc_object_base>::Guard curr_obj(lookup_and_lock(srv.badge()));
+		Object_pool<Rpc_object_base>::Guard curr_obj(_pool.lookup_and_lock(srv.badge()));
 		if (!curr_obj)
 			continue;
 
@@ -76,8 +77,10 @@ void Rpc_entrypoint::entry()
 		}
 
 		/* dispatch request */
+		Trace::event(Trace::RPC_DISPATCH, opcode, srv.badge());
 		try { srv.ret(_curr_obj->dispatch(opcode, srv, srv)); }
 		catch (Blocking_canceled) { }
+		Trace::event(Trace::RPC_REPLY, opcode, srv.badge());
 
 		{
 			Lock::Guard lock_guard(_curr_obj_lock);
@@ -13,7 +13,9 @@
 
 #include <base/signal.h>
 #include <base/thread.h>
+#include <base/rw_lock.h>
 #include <signal_session/connection.h>
+#include <trace/events.h>
 
 using namespace Genode;
 
@@ -114,33 +116,44 @@ namespace Genode {
 		private:
 
 			/*
-			 * Currently, the registry is just a linked list. If this becomes a
-			 * scalability problem, we might introduce a more sophisticated
-			 * associative data structure.
+			 * The registry is a hash table with a linked list per bucket.
+			 * The bucket is selected by the address of the context, which
+			 * is never dereferenced before the context is found to be
+			 * registered.
 			 */
-			Lock mutable                        _lock;
-			List<List_element<Signal_context> > _list;
+			enum { NUM_BUCKETS = 256 };
+
+			typedef List<List_element<Signal_context> > Bucket;
+
+			Rw_lock mutable _lock;
+			Bucket          _buckets[NUM_BUCKETS];
+
+			Bucket       &_bucket(Signal_context const *context) {
+				return _buckets[((addr_t)context >> 4) % NUM_BUCKETS]; }
+
+			Bucket const &_bucket(Signal_context const *context) const {
+				return _buckets[((addr_t)context >> 4) % NUM_BUCKETS]; }
 
 		public:
 
 			void insert(List_element<Signal_context> *le)
 			{
-				Lock::Guard guard(_lock);
-				_list.insert(le);
+				Rw_lock::Write_guard guard(_lock);
+				_bucket(le->object()).insert(le);
 			}
 
 			void remove(List_element<Signal_context> *le)
 			{
-				Lock::Guard guard(_lock);
-				_list.remove(le);
+				Rw_lock::Write_guard guard(_lock);
+				_bucket(le->object()).remove(le);
 			}
 
 			bool test_and_lock(Signal_context *context) const
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Read_guard guard(_lock);
 
-				/* search list for context */
-				List_element<Signal_context> *le = _list.first();
+				/* search bucket for context */
+				List_element<Signal_context> *le = _bucket(context).first();
 				for ( ; le; le = le->next()) {
 
 					if (context == le->object()) {
@@ -204,6 +217,7 @@ Signal::Signal(Signal::Data data) : _data(data)
 
 void Signal_transmitter::submit(unsigned cnt)
 {
+	Trace::event(Trace::SIGNAL_SUBMIT, _context.local_name(), cnt);
 	signal_connection()->submit(_context, cnt);
 }
 
@@ -224,6 +238,18 @@ void Signal_receiver::_unsynchronized_dissolve(Signal_context *context)
 	/* remove context from context list */
 	_contexts.remove(&context->_receiver_le);
 
+	/* drop pending signal that was not picked up yet */
+	{
+		Lock::Guard lock_guard(context->_lock);
+		Lock::Guard pending_lock_guard(_pending_lock);
+
+		if (context->_pending_fe.is_enqueued())
+			_pending_contexts.remove(&context->_pending_fe);
+
+		context->_pending     = false;
+		context->_curr_signal = Signal::Data(0, 0);
+	}
+
 	/* unregister context from process-wide registry */
 	signal_context_registry()->remove(&context->_registry_le);
 }
@@ -290,19 +316,9 @@ void Signal_receiver::dissolve(Signal_context *context)
 
 bool Signal_receiver::pending()
 {
-	Lock::Guard list_lock_guard(_contexts_lock);
-
-	/* look up the contexts for the pending signal */
-	for (List_element<Signal_context> *le = _contexts.first(); le; le = le->next()) {
-
-		Signal_context *context = le->object();
-
-		Lock::Guard lock_guard(context->_lock);
+	Lock::Guard pending_lock_guard(_pending_lock);
 
-		if (context->_pending)
-			return true;
-	}
-	return false;
+	return !_pending_contexts.empty();
 }
 
 
@@ -313,41 +329,50 @@ Signal Signal_receiver::wait_for_signal()
 		/* block until the receiver has received a signal */
 		_signal_available.down();
 
+		/* prevent the dissolving of contexts while picking up the signal */
 		Lock::Guard list_lock_guard(_contexts_lock);
 
-		/* look up the contexts for the pending signal */
-		for (List_element<Signal_context> *le = _contexts.first(); le; le = le->next()) {
-
-			Signal_context *context = le->object();
-
-			Lock::Guard lock_guard(context->_lock);
-
-			/* check if context has a pending signal */
-			if (!context->_pending)
-				continue;
-
-			context->_pending = false;
-			Signal::Data result = context->_curr_signal;
-
-			/* invalidate current signal in context */
-			context->_curr_signal = Signal::Data(0, 0);
-
-			if (result.num == 0)
-				PWRN("returning signal with num == 0");
-
-			/* return last received signal */
-			return result;
+		/* take the context that became pending first */
+		Fifo_element<Signal_context> *fe = 0;
+		{
+			Lock::Guard pending_lock_guard(_pending_lock);
+			fe = _pending_contexts.dequeue();
 		}
 
 		/*
-		 * Normally, we should never arrive at this point because that would
-		 * mean, the '_signal_available' semaphore was increased without
+		 * Normally, we should never encounter an empty queue because that
+		 * would mean, the '_signal_available' semaphore was increased without
 		 * registering the signal in any context associated to the receiver.
 		 *
 		 * However, if a context gets dissolved right after submitting a
 		 * signal, we may have increased the semaphore already. In this case
-		 * the signal-causing context is absent from the list.
+		 * the signal-causing context is absent from the queue.
 		 */
+		if (!fe)
+			continue;
+
+		Signal_context *context = fe->object();
+
+		Lock::Guard lock_guard(context->_lock);
+
+		/*
+		 * Signals that arrived after dequeuing the context are accumulated
+		 * in '_curr_signal'. Because '_pending' is still set, the context
+		 * was not enqueued a second time meanwhile.
+		 */
+		context->_pending = false;
+		Signal::Data result = context->_curr_signal;
+
+		/* invalidate current signal in context */
+		context->_curr_signal = Signal::Data(0, 0);
+
+		if (result.num == 0)
+			PWRN("returning signal with num == 0");
+
+		Trace::event(Trace::SIGNAL_RECEIVED, (addr_t)result.context, result.num);
+
+		/* return last received signal */
+		return result;
 	}
 	return Signal::Data(0, 0); /* unreachable */
 }
@@ -368,6 +393,11 @@ void Signal_receiver::local_submit(Signal::Data ns)
 	/* wake up the receiver if the context becomes pending */
 	if (!context->_pending) {
 		context->_pending = true;
+
+		{
+			Lock::Guard pending_lock_guard(_pending_lock);
+			_pending_contexts.enqueue(&context->_pending_fe);
+		}
 		_signal_available.up();
 	}
 }
@@ -0,0 +1,230 @@
+/*
+ * \brief  Recording of trace events
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/thread.h>
+#include <trace/logger.h>
+#include <cpu/atomic.h>
+
+using namespace Genode;
+using namespace Genode::Trace;
+
+
+unsigned volatile Control::_enabled;
+
+
+/**
+ * Size of the buffers allocated by 'Control::arm'
+ */
+static size_t volatile _buffer_size;
+
+
+/**
+ * Registry of all loggers
+ */
+static Lock &registry_lock()
+{
+	static Lock lock;
+	return lock;
+}
+
+
+static List<Logger> &registry()
+{
+	static List<Logger> list;
+	return list;
+}
+
+
+/**
+ * Return logger of the main thread
+ *
+ * The logger is constructed by 'Control::enable' and 'Control::arm', which
+ * prevents the construction from within a trace point.
+ */
+static Logger *main_logger()
+{
+	static Logger logger("main");
+	return &logger;
+}
+
+
+char const *Trace::event_name(unsigned type)
+{
+	static char const *names[NUM_EVENT_TYPES] = {
+		"rpc_call", "rpc_returned", "rpc_dispatch", "rpc_reply",
+		"signal_submit", "signal_received", "lock_contended",
+		"page_fault", "packet_submit", "packet_ack" };
+
+	return type < NUM_EVENT_TYPES ? names[type] : "unknown";
+}
+
+
+void Trace::log(Event_type type, unsigned long arg0, unsigned long arg1)
+{
+	Thread_base * const myself = Thread_base::myself();
+	if (myself) {
+		myself->trace_logger()->log(type, arg0, arg1);
+		return;
+	}
+
+	/*
+	 * A caller without 'Thread_base' object is the main thread or a thread
+	 * not created via Genode's thread API. The buffer of the main logger
+	 * supports a single writer only. So if another such thread is recording
+	 * an event at the same time, the event gets dropped.
+	 */
+	static int volatile main_logger_busy;
+	if (!cmpxchg(&main_logger_busy, 0, 1))
+		return;
+
+	main_logger()->log(type, arg0, arg1);
+
+	/* complete the recording before releasing the buffer */
+	__sync_synchronize();
+	main_logger_busy = 0;
+}
+
+
+/************
+ ** Logger **
+ ************/
+
+void Logger::_alloc_buffer(size_t size)
+{
+	try {
+		Ram_dataspace_capability ds = env()->ram_session()->alloc(size);
+
+		Buffer *buffer = env()->rm_session()->attach(ds);
+		buffer->init(size, _name);
+
+		_ds     = ds;
+		_buffer = buffer;
+	}
+	catch (...) { PWRN("could not allocate trace buffer for '%s'", _name); }
+}
+
+
+Logger::Logger(char const *name) : _buffer(0)
+{
+	strncpy(_name, name, sizeof(_name));
+
+	Lock::Guard guard(registry_lock());
+
+	registry().insert(this);
+
+	if (_buffer_size)
+		_alloc_buffer(_buffer_size);
+}
+
+
+Logger::~Logger()
+{
+	{
+		Lock::Guard guard(registry_lock());
+		registry().remove(this);
+	}
+
+	Buffer * const buffer = _buffer;
+	if (!buffer)
+		return;
+
+	_buffer = 0;
+	env()->rm_session()->detach(buffer);
+	env()->ram_session()->free(_ds);
+}
+
+
+/*************
+ ** Control **
+ *************/
+
+void Control::enable(unsigned events)
+{
+	main_logger();
+
+	_enabled = events;
+}
+
+
+void Control::arm(size_t buffer_size)
+{
+	main_logger();
+
+	Lock::Guard guard(registry_lock());
+
+	if (buffer_size < sizeof(Buffer) + 2*sizeof(Event)) {
+		PWRN("trace-buffer size %zd too small", buffer_size);
+		return;
+	}
+
+	_buffer_size = buffer_size;
+
+	for (Logger *l = registry().first(); l; l = l->next())
+		if (!l->_buffer)
+			l->_alloc_buffer(buffer_size);
+}
+
+
+size_t Control::buffer_size() { return _buffer_size; }
+
+
+void Control::for_each_buffer(Buffer_handler &handler)
+{
+	Lock::Guard guard(registry_lock());
+
+	for (Logger *l = registry().first(); l; l = l->next())
+		if (l->_buffer)
+			handler.handle_buffer(l->_ds, *l->_buffer);
+}
+
+
+void Control::dump()
+{
+	struct Dumper : Buffer_handler
+	{
+		void handle_buffer(Ram_dataspace_capability, Buffer const &buffer)
+		{
+			unsigned long const head = buffer.head();
+			unsigned long       lost = 0;
+
+			printf("trace buffer: events=%lu thread=%s\n", head, buffer.name());
+
+			for (unsigned long seq = buffer.tail(); seq < head; seq++) {
+
+				Event e;
+				if (!buffer.read(seq, &e)) {
+					lost++;
+					continue;
+				}
+
+				printf("trace: %llu %s %lx %lx %s\n",
+				       (unsigned long long)e.time, event_name(e.type),
+				       e.arg[0], e.arg[1], buffer.name());
+			}
+
+			if (lost)
+				printf("trace buffer: lost=%lu thread=%s\n", lost, buffer.name());
+		}
+	} dumper;
+
+	/* do not record the RPCs for printing the trace */
+	unsigned const events = _enabled;
+	_enabled = 0;
+
+	for_each_buffer(dumper);
+
+	_enabled = events;
+}
@@ -52,7 +52,8 @@ class Context_area_rm_session : public Rm_session
 		Local_addr attach(Dataspace_capability ds_cap,
 		                  size_t size, off_t offset,
 		                  bool use_local_addr, Local_addr local_addr,
-		                  bool executable)
+		                  bool executable,
+		                  bool populate)
 		{
 			Dataspace_component *ds =
 				dynamic_cast<Dataspace_component*>(Dataspace_capability::deref(ds_cap));
@@ -184,6 +185,9 @@ class Context_area_ram_session : public Ram_session
 			platform_specific()->ram_alloc()->free(phys_addr, size);
 		}
 
+		Ram_dataspace_capability clone(Ram_dataspace_capability) {
+			return Ram_dataspace_capability(); }
+
 		int ref_account(Ram_session_capability ram_session) { return 0; }
 
 		int transfer_quota(Ram_session_capability ram_session, size_t amount) { return 0; }
@@ -39,7 +39,8 @@ namespace Genode {
 			Local_addr attach(Dataspace_capability ds_cap, size_t size=0,
 			                  off_t offset=0, bool use_local_addr = false,
 			                  Local_addr local_addr = 0,
-			                  bool executable = false)
+			                  bool executable = false,
+			                  bool populate = false)
 			{
 				Object_pool<Dataspace_component>::Guard
 					ds(_ds_ep->lookup_and_lock(ds_cap));
@@ -93,6 +93,13 @@ namespace Genode {
 			 * Return number of physical CPUs present in the platform
 			 */
 			virtual unsigned num_cpus() const { return 1; }
+
+			/**
+			 * Return amount of memory kept pre-zeroed for RAM dataspaces
+			 *
+			 * A value of 0 disables the pool of pre-zeroed memory.
+			 */
+			virtual size_t ram_pool_capacity() const { return 4*1024*1024; }
 	};
 
 
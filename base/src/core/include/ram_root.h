@@ -26,6 +26,7 @@ namespace Genode {
 
 			Range_allocator *_ram_alloc;
 			Rpc_entrypoint  *_ds_ep;
+			Zeroed_ram_pool *_zeroed_pool;
 
 		protected:
 
@@ -33,7 +34,7 @@ namespace Genode {
 			{
 				return new (md_alloc())
 					Ram_session_component(_ds_ep, ep(), _ram_alloc,
-					                      md_alloc(), args);
+					                      md_alloc(), args, 0, _zeroed_pool);
 			}
 
 			void _upgrade_session(Ram_session_component *ram, const char *args)
@@ -51,14 +52,16 @@ namespace Genode {
 			 * \param ds_ep       entry point for managing dataspaces
 			 * \param ram_alloc   pool of memory to be assigned to ram sessions
 			 * \param md_alloc    meta-data allocator to be used by root component
+			 * \param zeroed_pool pool of pre-zeroed memory, or 0 if disabled
 			 */
 			Ram_root(Rpc_entrypoint  *session_ep,
 			         Rpc_entrypoint  *ds_ep,
 			         Range_allocator *ram_alloc,
-			         Allocator       *md_alloc)
+			         Allocator       *md_alloc,
+			         Zeroed_ram_pool *zeroed_pool = 0)
 			:
 				Root_component<Ram_session_component>(session_ep, md_alloc),
-				_ram_alloc(ram_alloc), _ds_ep(ds_ep) { }
+				_ram_alloc(ram_alloc), _ds_ep(ds_ep), _zeroed_pool(zeroed_pool) { }
 	};
 }
 
@@ -23,6 +23,7 @@
 
 /* core includes */
 #include <dataspace_component.h>
+#include <zeroed_ram_pool.h>
 
 namespace Genode {
 
@@ -49,10 +50,14 @@ namespace Genode {
 			Allocator_guard         _md_alloc;     /* guarded meta-data allocator */
 			Ds_slab                 _ds_slab;      /* meta-data allocator         */
 			Ram_session_component  *_ref_account;  /* reference ram session       */
+			Zeroed_ram_pool        *_zeroed_pool;  /* pre-zeroed memory, or 0     */
 
 			enum { MAX_LABEL_LEN = 64 };
 			char _label[MAX_LABEL_LEN];
 
+			/* minimum size of dataspaces backed by huge pages, 0 if disabled */
+			size_t _huge_pages_min;
+
 			/**
 			 * List of RAM sessions that use us as their reference account
 			 */
@@ -101,10 +106,24 @@ namespace Genode {
 			 */
 			void _revoke_ram_ds(Dataspace_component *ds);
 
+			/*
+			 * The pool of pre-zeroed memory uses '_clear_ds' for clearing
+			 * blocks in the background.
+			 */
+			friend class Zeroed_ram_pool;
+
 			/**
 			 * Zero-out content of dataspace
 			 */
-			void _clear_ds(Dataspace_component *ds);
+			static void _clear_ds(Dataspace_component *ds);
+
+			/**
+			 * Copy content of dataspace 'src' to dataspace 'dst'
+			 *
+			 * \return false if the platform does not support copying
+			 *         dataspaces within core
+			 */
+			bool _copy_ds(Dataspace_component *src, Dataspace_component *dst);
 
 		public:
 
@@ -120,6 +139,8 @@ namespace Genode {
 			 * \param md_alloc        meta-data allocator
 			 * \param md_ram_quota    limit of meta-data backing store
 			 * \param quota_limit     initial quota limit
+			 * \param zeroed_pool     pool of pre-zeroed memory, or 0 for
+			 *                        clearing each dataspace on allocation
 			 *
 			 * The 'quota_limit' parameter is only used for the very
 			 * first ram session in the system. All other ram session
@@ -130,7 +151,8 @@ namespace Genode {
 			                      Range_allocator *ram_alloc,
 			                      Allocator       *md_alloc,
 			                      const char      *args,
-			                      size_t           quota_limit = 0);
+			                      size_t           quota_limit = 0,
+			                      Zeroed_ram_pool *zeroed_pool = 0);
 
 			/**
 			 * Destructor
@@ -162,6 +184,7 @@ namespace Genode {
 
 			Ram_dataspace_capability alloc(size_t, bool);
 			void free(Ram_dataspace_capability);
+			Ram_dataspace_capability clone(Ram_dataspace_capability);
 			int ref_account(Ram_session_capability);
 			int transfer_quota(Ram_session_capability, size_t);
 			size_t quota() { return _quota_limit; }
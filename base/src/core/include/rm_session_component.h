@@ -27,6 +27,7 @@
 #include <base/rpc_server.h>
 #include <util/list.h>
 #include <util/fifo.h>
+#include <util/avl_tree.h>
 
 /* core includes */
 #include <platform.h>
@@ -211,6 +212,16 @@ namespace Genode {
 			 */
 			void unmap(addr_t core_local_base, addr_t virt_base, size_t size);
 
+			/**
+			 * Install memory mappings for the specified virtual address range
+			 *
+			 * This function is used to populate a region eagerly at attach
+			 * time. On kernels where core cannot map into the address space
+			 * of a client outside of a page fault, it has no effect.
+			 */
+			void map(addr_t core_local_base, addr_t virt_base, size_t size,
+			         bool writeable);
+
 			bool has_same_address_space(Rm_client const &other)
 			{
 				return other._address_space == _address_space;
@@ -234,7 +245,16 @@ namespace Genode {
 			 ** Paging facility **
 			 *********************/
 
-			class Rm_region_ref : public List<Rm_region_ref>::Element
+			/**
+			 * Entry of the region index
+			 *
+			 * The index contains the attached regions only, ordered by their
+			 * base address. In contrast to the region map, which also keeps
+			 * track of the unused parts of the address space and, on
+			 * platforms without unmap support, of stale regions, the index
+			 * refers to the currently attached regions only.
+			 */
+			class Rm_region_ref : public Avl_node<Rm_region_ref>
 			{
 				private:
 
@@ -245,6 +265,26 @@ namespace Genode {
 					Rm_region_ref(Rm_region *region) : _region(region) { }
 
 					Rm_region* region() const { return _region; }
+
+					/**
+					 * Avl_node interface
+					 */
+					bool higher(Rm_region_ref *r) {
+						return r->_region->base() > _region->base(); }
+
+					/**
+					 * Lookup region containing the specified address
+					 */
+					Rm_region_ref *find_by_addr(addr_t addr)
+					{
+						addr_t const base = _region->base();
+
+						if (addr >= base && addr - base < _region->size())
+							return this;
+
+						Rm_region_ref *r = this->child(addr > base);
+						return r ? r->find_by_addr(addr) : 0;
+					}
 			};
 
 
@@ -281,7 +321,7 @@ namespace Genode {
 			                                                region list */
 			Allocator_avl_tpl<Rm_region>  _map;          /* region map for attach,
 			                                                detach, pagefaults */
-			List<Rm_region_ref>           _regions;      /* region list for destruction */
+			Avl_tree<Rm_region_ref>       _regions;      /* index of attached regions */
 
 			Fifo<Rm_faulter>              _faulters;     /* list of threads that faulted at
 			                                                the region-manager session and wait
@@ -293,6 +333,32 @@ namespace Genode {
 			Rm_dataspace_component        _ds;           /* dataspace representation of region map */
 			Dataspace_capability          _ds_cap;
 
+			/**
+			 * Lookup index entry of the region containing the address
+			 */
+			Rm_region_ref *_region_ref(addr_t addr)
+			{
+				Rm_region_ref *first = _regions.first();
+				return first ? first->find_by_addr(addr) : 0;
+			}
+
+			/**
+			 * Attach dataspace, must be called with '_lock' held
+			 */
+			Local_addr _attach(Dataspace_component *dsc, size_t size, off_t offset,
+			                   bool use_local_addr, Local_addr local_addr,
+			                   bool populate);
+
+			/**
+			 * Map region into the address spaces of all clients
+			 */
+			void _populate(Dataspace_component *dsc, Rm_region *region);
+
+			/**
+			 * Detach region, must be called with '_lock' held
+			 */
+			void _detach(Local_addr local_addr);
+
 		public:
 
 			/**
@@ -357,8 +423,10 @@ namespace Genode {
 			 ** Region manager session interface **
 			 **************************************/
 
-			Local_addr       attach        (Dataspace_capability, size_t, off_t, bool, Local_addr, bool);
+			Local_addr       attach        (Dataspace_capability, size_t, off_t, bool, Local_addr, bool, bool);
 			void             detach        (Local_addr);
+			Local_addr_batch attach_many   (Dataspace_capability, Attachment_batch const &);
+			void             detach_many   (Local_addr_batch const &);
 			Pager_capability add_client    (Thread_capability);
 			void             remove_client (Pager_capability);
 			void             fault_handler (Signal_context_capability handler);
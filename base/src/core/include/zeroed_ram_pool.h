@@ -0,0 +1,197 @@
+/*
+ * \brief  Pool of pre-zeroed physical memory for RAM dataspaces
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _CORE__INCLUDE__ZEROED_RAM_POOL_H_
+#define _CORE__INCLUDE__ZEROED_RAM_POOL_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <base/allocator.h>
+
+namespace Genode {
+
+	/**
+	 * Pool of pre-zeroed blocks of physical memory
+	 *
+	 * Core must hand out RAM dataspaces filled with zeros. Instead of clearing
+	 * the memory of each new dataspace in the context of the allocating
+	 * client, core keeps a pool of cleared blocks for common dataspace sizes.
+	 * The pool is filled by a background thread, which also clears the
+	 * memory of freed dataspaces. Allocations that cannot be served from the
+	 * pool fall back to synchronous clearing.
+	 *
+	 * The memory held by the pool is bounded by the capacity of the pool,
+	 * which must be kept out of the quota distributed to the RAM sessions.
+	 */
+	class Zeroed_ram_pool : Thread<4096*sizeof(long)>
+	{
+		public:
+
+			enum {
+				MIN_SIZE_LOG2    = 12,
+				MAX_SIZE_LOG2    = 18,
+				NUM_CLASSES      = MAX_SIZE_LOG2 - MIN_SIZE_LOG2 + 1,
+				MAX_BLOCKS       = 128,  /* blocks per size class at most */
+				NUM_LATENCY_LOG2 = 32,   /* buckets of latency histogram  */
+			};
+
+			/**
+			 * Refill policy
+			 */
+			struct Policy
+			{
+				/* amount of memory kept pre-zeroed, distributed over the sizes */
+				size_t capacity;
+
+				/* refill a size class if it drops below this percentage */
+				unsigned low_watermark_percent;
+
+				/* report latency percentiles every n allocations, 0 disables */
+				unsigned long report_interval;
+
+				Policy(size_t capacity = 4*1024*1024,
+				       unsigned low_watermark_percent = 50,
+				       unsigned long report_interval = 0)
+				:
+					capacity(capacity),
+					low_watermark_percent(low_watermark_percent),
+					report_interval(report_interval)
+				{ }
+			};
+
+			/**
+			 * Cleared block as handed out by 'take'
+			 */
+			struct Block
+			{
+				addr_t phys;
+				addr_t core_local;  /* core-local mapping, 0 if none */
+
+				Block() : phys(0), core_local(0) { }
+			};
+
+		private:
+
+			struct Size_class
+			{
+				Block    clean[MAX_BLOCKS];
+				addr_t   dirty[MAX_BLOCKS];  /* freed blocks, not yet cleared */
+				unsigned num_clean;
+				unsigned num_dirty;
+				unsigned num_clearing;       /* blocks in the refill thread */
+				unsigned target;             /* number of blocks to keep */
+
+				Size_class()
+				: num_clean(0), num_dirty(0), num_clearing(0), target(0) { }
+
+				unsigned num_blocks() const {
+					return num_clean + num_dirty + num_clearing; }
+			};
+
+			Range_allocator &_ram_alloc;
+			Policy const     _policy;
+			Size_class       _classes[NUM_CLASSES];
+			Lock             _lock;
+			Semaphore        _refill_sem;
+			bool             _refill_pending;
+
+			/*
+			 * Histogram of allocation latencies in CPU cycles, bucket i counts
+			 * the latencies in the range [2^i, 2^(i+1))
+			 */
+			unsigned long _latency[NUM_LATENCY_LOG2];
+			unsigned long _num_allocs;
+			unsigned long _num_hits;
+
+			/**
+			 * Return size class of dataspace size, or -1 if not pooled
+			 */
+			static int _size_class(size_t size);
+
+			static size_t _class_size(int i) { return 1UL << (MIN_SIZE_LOG2 + i); }
+
+			/**
+			 * Wake up refill thread, must be called with '_lock' held
+			 */
+			void _request_refill();
+
+			/**
+			 * Return true if size class dropped below its low watermark
+			 */
+			bool _below_watermark(Size_class const &c) const {
+				return c.num_blocks()*100 < c.target*_policy.low_watermark_percent; }
+
+			/**
+			 * Clear block, must be called without holding '_lock'
+			 */
+			Block _clear(addr_t phys, size_t size);
+
+			/**
+			 * Fill size class up to its target
+			 */
+			void _refill(int i);
+
+			/**
+			 * Print latency percentiles, must be called with '_lock' held
+			 */
+			void _report_latency();
+
+			void entry();
+
+		public:
+
+			/**
+			 * Constructor
+			 *
+			 * \param ram_alloc  allocator of physical memory
+			 * \param policy     refill policy
+			 */
+			Zeroed_ram_pool(Range_allocator &ram_alloc, Policy const &policy);
+
+			/**
+			 * Start filling the pool
+			 *
+			 * Until this function is called, the pool neither takes memory
+			 * from the allocator nor keeps freed memory. So the quota
+			 * distributed by core can be determined independently from the
+			 * progress of the refill thread.
+			 */
+			void start_refill();
+
+			/**
+			 * Obtain cleared block for a dataspace of the given size
+			 *
+			 * \return false if the pool has no block of the size
+			 */
+			bool take(size_t size, Block *out_block);
+
+			/**
+			 * Hand back memory of a freed dataspace for clearing and reuse
+			 *
+			 * \return false if the pool does not need the memory, in which
+			 *         case the caller must return it to the allocator
+			 */
+			bool recycle(addr_t phys, size_t size);
+
+			/**
+			 * Record latency of a RAM-dataspace allocation
+			 *
+			 * \param cycles  duration of the allocation in CPU cycles
+			 * \param hit     true if the allocation was served by the pool
+			 */
+			void record_latency(unsigned long long cycles, bool hit);
+	};
+}
+
+#endif /* _CORE__INCLUDE__ZEROED_RAM_POOL_H_ */
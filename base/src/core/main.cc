@@ -37,6 +37,11 @@
 using namespace Genode;
 
 
+/* print latencies of RAM-dataspace allocations every n allocations */
+static const bool verbose_ram_pool = false;
+enum { RAM_POOL_REPORT_INTERVAL = 1000 };
+
+
 /* support for cap session component */
 long Cap_session_component::_unique_id_cnt;
 
@@ -166,8 +171,25 @@ int main()
 	 */
 	static Sliced_heap sliced_heap(env()->ram_session(), env()->rm_session());
 
+	/*
+	 * Create pool of pre-zeroed memory for RAM dataspaces, which takes the
+	 * clearing of dataspaces out of the allocation path. The pool is limited
+	 * to a small fraction of the physical memory.
+	 */
+	Genode::size_t const ram_pool_capacity =
+		min(platform()->ram_pool_capacity(), platform()->ram_alloc()->avail()/32);
+
+	Zeroed_ram_pool *zeroed_ram_pool = 0;
+	if (ram_pool_capacity)
+		zeroed_ram_pool = new (env()->heap())
+			Zeroed_ram_pool(*platform()->ram_alloc(),
+			                Zeroed_ram_pool::Policy(ram_pool_capacity, 50,
+			                                        verbose_ram_pool
+			                                        ? RAM_POOL_REPORT_INTERVAL : 0));
+
 	static Cap_root     cap_root     (e, &sliced_heap);
-	static Ram_root     ram_root     (e, e, platform()->ram_alloc(), &sliced_heap);
+	static Ram_root     ram_root     (e, e, platform()->ram_alloc(), &sliced_heap,
+	                                  zeroed_ram_pool);
 	static Rom_root     rom_root     (e, e, platform()->rom_fs(), &sliced_heap);
 	static Rm_root      rm_root      (e, e, e, &sliced_heap, core_env()->cap_session(),
 	                                  platform()->vm_start(), platform()->vm_size());
@@ -225,10 +247,18 @@ int main()
 	/* transfer all left memory to init, but leave some memory left for core */
 	/* NOTE: exception objects thrown in core components are currently allocated on
 	         core's heap and not accounted by the component's meta data allocator */
-	Genode::size_t init_quota = platform()->ram_alloc()->avail() - 140*1024;
+	/*
+	 * The memory of the pool of pre-zeroed memory is not available to init.
+	 * The pool starts taking memory not before init's quota is determined.
+	 */
+	Genode::size_t init_quota = platform()->ram_alloc()->avail() - 140*1024
+	                          - ram_pool_capacity;
 	env()->ram_session()->transfer_quota(init_ram_session_cap, init_quota);
 	PDBG("transferred %zd MB to init", init_quota / (1024*1024));
 
+	if (zeroed_ram_pool)
+		zeroed_ram_pool->start_refill();
+
 	Core_child *init = new (env()->heap())
 		Core_child(Rom_session_client(init_rom_session_cap).dataspace(),
 		           core_env()->cap_session(), init_ram_session_cap,
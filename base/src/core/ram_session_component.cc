@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <base/printf.h>
 #include <util/arg_string.h>
+#include <trace/timestamp.h>
 
 /* core includes */
 #include <ram_session_component.h>
@@ -37,7 +38,8 @@ void Ram_session_component::_free_ds(Dataspace_component *ds)
 	if (!ds) return;
 	if (!ds->owner(this)) return;
 
-	size_t ds_size = ds->size();
+	size_t ds_size   = ds->size();
+	addr_t phys_addr = ds->phys_addr();
 
 	/* tell entry point to forget the dataspace */
 	_ds_ep->dissolve(ds);
@@ -47,12 +49,18 @@ void Ram_session_component::_free_ds(Dataspace_component *ds)
 
 	/* XXX: remove dataspace from all RM sessions */
 
-	/* free physical memory that was backing the dataspace */
-	_ram_alloc->free((void *)ds->phys_addr(), ds_size);
-
 	/* call dataspace destructors and free memory */
 	destroy(&_ds_slab, ds);
 
+	/*
+	 * Free physical memory that was backing the dataspace. The memory is
+	 * preferably handed to the pool of pre-zeroed memory, which clears it in
+	 * the background. This must happen after the dataspace was detached from
+	 * all RM sessions.
+	 */
+	if (!_zeroed_pool || !_zeroed_pool->recycle(phys_addr, ds_size))
+		_ram_alloc->free((void *)phys_addr, ds_size);
+
 	/* adjust payload */
 	Lock::Guard lock_guard(_ref_members_lock);
 	_payload -= ds_size;
@@ -111,6 +119,8 @@ Ram_dataspace_capability Ram_session_component::alloc(size_t ds_size, bool cache
 	/* zero-sized dataspaces are not allowed */
 	if (!ds_size) return Ram_dataspace_capability();
 
+	Trace::Timestamp const start = Trace::timestamp();
+
 	/* dataspace allocation granularity is page size */
 	ds_size = align_addr(ds_size, 12);
 
@@ -133,6 +143,16 @@ Ram_dataspace_capability Ram_session_component::alloc(size_t ds_size, bool cache
 		throw Quota_exceeded();
 	}
 
+	/*
+	 * Take pre-zeroed memory from the pool
+	 *
+	 * Non-cached dataspaces are not served from the pool because their
+	 * clearing must flush the cache lines of the backing store.
+	 */
+	Zeroed_ram_pool::Block zeroed;
+	bool const pooled = cached && _zeroed_pool
+	                 && _zeroed_pool->take(ds_size, &zeroed);
+
 	/*
 	 * Allocate physical backing store
 	 *
@@ -141,9 +161,9 @@ Ram_dataspace_capability Ram_session_component::alloc(size_t ds_size, bool cache
 	 * If this does not work, we subsequently weaken the alignment constraint
 	 * until the allocation succeeds.
 	 */
-	void *ds_addr = 0;
-	bool alloc_succeeded = false;
-	for (size_t align_log2 = log2(ds_size); align_log2 >= 12; align_log2--) {
+	void *ds_addr = (void *)zeroed.phys;
+	bool alloc_succeeded = pooled;
+	for (size_t align_log2 = log2(ds_size); !pooled && align_log2 >= 12; align_log2--) {
 		if (_ram_alloc->alloc_aligned(ds_size, &ds_addr, align_log2).is_ok()) {
 			alloc_succeeded = true;
 			break;
@@ -178,9 +198,13 @@ Ram_dataspace_capability Ram_session_component::alloc(size_t ds_size, bool cache
 	/*
 	 * Fill new dataspaces with zeros. For non-cached RAM dataspaces, this
 	 * function must also make sure to flush all cache lines related to the
-	 * address range used by the dataspace.
+	 * address range used by the dataspace. Memory taken from the pool is
+	 * already cleared, possibly via a core-local mapping that we keep.
 	 */
-	_clear_ds(ds);
+	if (pooled)
+		ds->assign_core_local_addr((void *)zeroed.core_local);
+	else
+		_clear_ds(ds);
 
 	if (verbose)
 		PDBG("ds_size=%zd, used_quota=%zd quota_limit=%zd",
@@ -191,6 +215,9 @@ Ram_dataspace_capability Ram_session_component::alloc(size_t ds_size, bool cache
 	/* create native shared memory representation of dataspace */
 	_export_ram_ds(ds);
 
+	if (_zeroed_pool)
+		_zeroed_pool->record_latency(Trace::timestamp() - start, pooled);
+
 	Lock::Guard lock_guard(_ref_members_lock);
 	/* keep track of the used quota for actual payload */
 	_payload += ds_size;
@@ -210,6 +237,37 @@ void Ram_session_component::free(Ram_dataspace_capability ds_cap)
 }
 
 
+Ram_dataspace_capability Ram_session_component::clone(Ram_dataspace_capability src_cap)
+{
+	/* only dataspaces allocated from this session can be copied */
+	Object_pool<Dataspace_component>::Guard src(_ds_ep->lookup_and_lock(src_cap));
+	if (!src || !src->owner(this)) return Ram_dataspace_capability();
+
+	/* limit the time the entrypoint is occupied by the copy */
+	if (src->size() > MAX_CLONE_SIZE) return Ram_dataspace_capability();
+
+	/*
+	 * Call the functions of this class explicitly to bypass the locking of
+	 * a derived synchronized RAM session, which is held already.
+	 */
+	Ram_dataspace_capability dst_cap =
+		Ram_session_component::alloc(src->size(), !src->write_combined());
+
+	bool copied = false;
+	{
+		Object_pool<Dataspace_component>::Guard dst(_ds_ep->lookup_and_lock(dst_cap));
+		copied = dst && _copy_ds(src, dst);
+	}
+
+	if (!copied) {
+		Ram_session_component::free(dst_cap);
+		return Ram_dataspace_capability();
+	}
+
+	return dst_cap;
+}
+
+
 int Ram_session_component::ref_account(Ram_session_capability ram_session_cap)
 {
 	/* the reference account cannot be defined twice */
@@ -246,12 +304,14 @@ Ram_session_component::Ram_session_component(Rpc_entrypoint  *ds_ep,
                                              Range_allocator *ram_alloc,
                                              Allocator       *md_alloc,
                                              const char      *args,
-                                             size_t           quota_limit)
+                                             size_t           quota_limit,
+                                             Zeroed_ram_pool *zeroed_pool)
 :
 	_ds_ep(ds_ep), _ram_session_ep(ram_session_ep), _ram_alloc(ram_alloc),
 	_quota_limit(quota_limit), _payload(0),
 	_md_alloc(md_alloc, Arg_string::find_arg(args, "ram_quota").long_value(0)),
-	_ds_slab(&_md_alloc), _ref_account(0)
+	_ds_slab(&_md_alloc), _ref_account(0), _zeroed_pool(zeroed_pool),
+	_huge_pages_min(Arg_string::find_arg(args, "huge_pages_min").ulong_value(0))
 {
 	Arg_string::find_arg(args, "label").string(_label, sizeof(_label), "");
 }
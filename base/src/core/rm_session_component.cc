@@ -20,6 +20,7 @@
 #include <base/lock.h>
 #include <util/arg_string.h>
 #include <util/misc_math.h>
+#include <trace/events.h>
 
 /* core includes */
 #include <util.h>
@@ -173,6 +174,8 @@ int Rm_client::pager(Ipc_pager &pager)
 	if (verbose_page_faults)
 		print_page_fault("page fault", pf_addr, pf_ip, pf_type, badge());
 
+	Trace::event(Trace::PAGE_FAULT, pf_addr, pf_ip);
+
 	Rm_session_component            *curr_rm_session = member_rm_session();
 	Rm_session_component            *sub_rm_session  = 0; 
 	addr_t                           curr_rm_base    = 0;
@@ -343,22 +346,15 @@ void Rm_faulter::continue_after_resolved_fault()
  **************************************/
 
 Rm_session::Local_addr
-Rm_session_component::attach(Dataspace_capability ds_cap, size_t size,
-                             off_t offset, bool use_local_addr,
-                             Rm_session::Local_addr local_addr,
-                             bool executable)
+Rm_session_component::_attach(Dataspace_component *dsc, size_t size,
+                              off_t offset, bool use_local_addr,
+                              Rm_session::Local_addr local_addr,
+                              bool populate)
 {
-	/* serialize access */
-	Lock::Guard lock_guard(_lock);
-
 	/* offset must be positive and page-aligned */
 	if (offset < 0 || align_addr(offset, get_page_size_log2()) != offset)
 		throw Invalid_args();
 
-	/* check dataspace validity */
-	Object_pool<Dataspace_component>::Guard dsc(_ds_ep->lookup_and_lock(ds_cap));
-	if (!dsc) throw Invalid_dataspace();
-
 	if (!size) {
 		size = dsc->size() - offset;
 
@@ -426,7 +422,7 @@ Rm_session_component::attach(Dataspace_capability ds_cap, size_t size,
 	_map.metadata(r, Rm_region((addr_t)r, size, true, dsc, offset, this));
 	Rm_region *region = _map.metadata(r);
 
-	/* also update region list */
+	/* also update region index */
 	Rm_region_ref *p;
 	try { p = new(&_ref_slab) Rm_region_ref(region); }
 	catch (Allocator::Out_of_memory) {
@@ -441,7 +437,7 @@ Rm_session_component::attach(Dataspace_capability ds_cap, size_t size,
 
 	if (verbose)
 		PDBG("attach ds %p (a=%lx,s=%zx,o=%lx) @ [%lx,%lx)",
-		     (Dataspace_component *)dsc, dsc->phys_addr(), dsc->size(), offset, (addr_t)r, (addr_t)r + size);
+		     dsc, dsc->phys_addr(), dsc->size(), offset, (addr_t)r, (addr_t)r + size);
 
 	/* check if attach operation resolves any faulting region-manager clients */
 	for (Rm_faulter *faulter = _faulters.head(); faulter; ) {
@@ -457,10 +453,84 @@ Rm_session_component::attach(Dataspace_capability ds_cap, size_t size,
 		faulter = next;
 	}
 
+	if (populate)
+		_populate(dsc, region);
+
 	return r;
 }
 
 
+void Rm_session_component::_populate(Dataspace_component *dsc, Rm_region *region)
+{
+	/*
+	 * Managed dataspaces and I/O memory are left to the page-fault path,
+	 * which resolves them with the right attributes.
+	 */
+	if (dsc->is_managed() || dsc->is_io_mem() || !dsc->core_local_addr())
+		return;
+
+	Rm_client *prev_rc = 0;
+	for (Rm_client *rc = _clients.first(); rc;
+	     prev_rc = rc, rc = rc->List<Rm_client>::Element::next()) {
+
+		/* don't map into the same address space twice, see '_detach' */
+		if (prev_rc && prev_rc->has_same_address_space(*rc))
+			continue;
+
+		rc->map(dsc->core_local_addr() + region->offset(), region->base(),
+		        region->size(), dsc->writable());
+	}
+}
+
+
+Rm_session::Local_addr
+Rm_session_component::attach(Dataspace_capability ds_cap, size_t size,
+                             off_t offset, bool use_local_addr,
+                             Rm_session::Local_addr local_addr,
+                             bool executable,
+                             bool populate)
+{
+	/* serialize access */
+	Lock::Guard lock_guard(_lock);
+
+	/* check dataspace validity */
+	Object_pool<Dataspace_component>::Guard dsc(_ds_ep->lookup_and_lock(ds_cap));
+	if (!dsc) throw Invalid_dataspace();
+
+	return _attach(dsc, size, offset, use_local_addr, local_addr, populate);
+}
+
+
+Rm_session::Local_addr_batch
+Rm_session_component::attach_many(Dataspace_capability ds_cap,
+                                  Attachment_batch const &batch)
+{
+	/* serialize access */
+	Lock::Guard lock_guard(_lock);
+
+	/* check dataspace validity */
+	Object_pool<Dataspace_component>::Guard dsc(_ds_ep->lookup_and_lock(ds_cap));
+	if (!dsc) throw Invalid_dataspace();
+
+	Local_addr_batch result;
+	unsigned const count = min(batch.count, (unsigned)MAX_BATCH);
+	try {
+		for (unsigned i = 0; i < count; i++) {
+			Attachment const &a = batch.attachment[i];
+			result.add(_attach(dsc, a.size, a.offset, a.use_local_addr,
+			                   a.local_addr, a.populate));
+		}
+	} catch (...) {
+
+		/* revert the attachments of the batch */
+		for (unsigned i = 0; i < result.count; i++)
+			_detach(result.addr[i]);
+		throw;
+	}
+	return result;
+}
+
+
 static void unmap_managed(Rm_session_component *session, Rm_region *region, int level)
 {
 	for (Rm_region *managed = session->dataspace_component()->regions()->first();
@@ -487,19 +557,18 @@ static void unmap_managed(Rm_session_component *session, Rm_region *region, int
 }
 
 
-void Rm_session_component::detach(Local_addr local_addr)
+void Rm_session_component::_detach(Local_addr local_addr)
 {
-	/* serialize access */
-	Lock::Guard lock_guard(_lock);
-
-	/* read meta data for address */
-	Rm_region *region = _map.metadata(local_addr);
+	/* lookup region in the index of attached regions */
+	Rm_region_ref *ref = _region_ref(local_addr);
 
-	if (!region) {
+	if (!ref) {
 		PDBG("no attachment at %p", (void *)local_addr);
 		return;
 	}
 
+	Rm_region *region = ref->region();
+
 	Dataspace_component *dsc = region->dataspace();
 	if (!dsc)
 		PWRN("Rm_region of %p may be inconsistent!", this);
@@ -592,15 +661,29 @@ void Rm_session_component::detach(Local_addr local_addr)
 	 */
 	unmap_managed(this, region, 1);
 
-	/* update region list */
-	Rm_region_ref *p = _regions.first();
-	for (; p; p = p->next())
-		if (p->region() == region) break;
+	/* update region index */
+	_regions.remove(ref);
+	destroy(&_ref_slab, ref);
+}
 
-	if (p) {
-		_regions.remove(p);
-		destroy(&_ref_slab, p);
-	}
+
+void Rm_session_component::detach(Local_addr local_addr)
+{
+	/* serialize access */
+	Lock::Guard lock_guard(_lock);
+
+	_detach(local_addr);
+}
+
+
+void Rm_session_component::detach_many(Local_addr_batch const &batch)
+{
+	/* serialize access */
+	Lock::Guard lock_guard(_lock);
+
+	unsigned const count = min(batch.count, (unsigned)MAX_BATCH);
+	for (unsigned i = 0; i < count; i++)
+		_detach(batch.addr[i]);
 }
 
 
@@ -684,10 +767,12 @@ bool Rm_session_component::reverse_lookup(addr_t                dst_base,
 	addr_t fault_addr = dst_fault_area->fault_addr() - dst_base;
 
 	/* lookup region */
-	Rm_region *region = _map.metadata((void*)fault_addr);
-	if (!region)
+	Rm_region_ref *ref = _region_ref(fault_addr);
+	if (!ref)
 		return false;
 
+	Rm_region *region = ref->region();
+
 	/* request dataspace  backing the region */
 	*src_dataspace = region->dataspace();
 	if (!*src_dataspace)
@@ -836,7 +921,7 @@ Rm_session_component::~Rm_session_component()
 		void * local_addr;
 		{
 			Lock::Guard lock_guard(_lock);
-			ref = _ref_slab.first_object();
+			ref = _regions.first();
 			if (!ref) break;
 			local_addr = reinterpret_cast<void *>(ref->region()->base());
 		}
@@ -0,0 +1,240 @@
+/*
+ * \brief  Pool of pre-zeroed physical memory for RAM dataspaces
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <util/string.h>
+
+/* core includes */
+#include <zeroed_ram_pool.h>
+#include <ram_session_component.h>
+
+using namespace Genode;
+
+
+int Zeroed_ram_pool::_size_class(size_t size)
+{
+	for (int i = 0; i < NUM_CLASSES; i++)
+		if (size == _class_size(i))
+			return i;
+
+	return -1;
+}
+
+
+void Zeroed_ram_pool::_request_refill()
+{
+	if (_refill_pending)
+		return;
+
+	_refill_pending = true;
+	_refill_sem.up();
+}
+
+
+Zeroed_ram_pool::Block Zeroed_ram_pool::_clear(addr_t phys, size_t size)
+{
+	/*
+	 * The clearing is performed by the platform-specific support function of
+	 * the RAM session, which expects a dataspace. Hence, we wrap the block
+	 * into a temporary dataspace that is never handed out. Depending on the
+	 * platform, the function establishes a core-local mapping of the
+	 * dataspace, which we keep for the dataspace that will use the block.
+	 */
+	Dataspace_component ds(size, phys, false, true, 0);
+	Ram_session_component::_clear_ds(&ds);
+
+	Block block;
+	block.phys       = phys;
+	block.core_local = ds.core_local_addr();
+	return block;
+}
+
+
+void Zeroed_ram_pool::_refill(int i)
+{
+	size_t const size = _class_size(i);
+	Size_class  &c    = _classes[i];
+
+	for (;;) {
+
+		addr_t phys  = 0;
+		bool   dirty = false;
+
+		{
+			Lock::Guard guard(_lock);
+
+			/* clear freed blocks first, they are accounted to the pool */
+			if (c.num_dirty) {
+				phys  = c.dirty[--c.num_dirty];
+				dirty = true;
+			}
+
+			else if (c.num_blocks() >= c.target)
+				return;
+
+			/* account block while it is cleared */
+			c.num_clearing++;
+		}
+
+		/* allocate new block, naturally aligned if possible */
+		if (!dirty) {
+			void *addr = 0;
+			bool  ok   = false;
+			for (size_t align_log2 = log2(size); !ok && align_log2 >= 12; align_log2--)
+				ok = _ram_alloc.alloc_aligned(size, &addr, align_log2).is_ok();
+
+			if (!ok) {
+				Lock::Guard guard(_lock);
+				c.num_clearing--;
+				return;
+			}
+
+			phys = (addr_t)addr;
+		}
+
+		/* clear block without holding the lock */
+		Block const block = _clear(phys, size);
+
+		Lock::Guard guard(_lock);
+		c.num_clearing--;
+		c.clean[c.num_clean++] = block;
+	}
+}
+
+
+void Zeroed_ram_pool::entry()
+{
+	for (;;) {
+		_refill_sem.down();
+
+		{
+			Lock::Guard guard(_lock);
+			_refill_pending = false;
+		}
+
+		for (int i = 0; i < NUM_CLASSES; i++)
+			_refill(i);
+	}
+}
+
+
+void Zeroed_ram_pool::_report_latency()
+{
+	unsigned long percentile[] = { 50, 90, 99 };
+	unsigned long bound[]      = { 0, 0, 0 };
+	unsigned long max          = 0;
+
+	unsigned long count = 0;
+	for (unsigned i = 0; i < NUM_LATENCY_LOG2; i++) {
+		if (!_latency[i])
+			continue;
+
+		count += _latency[i];
+		max    = 1UL << i;
+
+		for (unsigned p = 0; p < sizeof(percentile)/sizeof(percentile[0]); p++)
+			if (!bound[p] && count*100 >= _num_allocs*percentile[p])
+				bound[p] = 2UL << i;
+	}
+
+	printf("RAM alloc latency (cycles): allocs=%lu pool_hits=%lu "
+	       "p50<%lu p90<%lu p99<%lu max<%lu\n",
+	       _num_allocs, _num_hits, bound[0], bound[1], bound[2], 2*max);
+}
+
+
+bool Zeroed_ram_pool::take(size_t size, Block *out_block)
+{
+	int const i = _size_class(size);
+	if (i < 0)
+		return false;
+
+	Lock::Guard guard(_lock);
+
+	Size_class &c = _classes[i];
+
+	if (!c.num_clean) {
+		_request_refill();
+		return false;
+	}
+
+	*out_block = c.clean[--c.num_clean];
+
+	if (_below_watermark(c))
+		_request_refill();
+
+	return true;
+}
+
+
+bool Zeroed_ram_pool::recycle(addr_t phys, size_t size)
+{
+	int const i = _size_class(size);
+	if (i < 0)
+		return false;
+
+	Lock::Guard guard(_lock);
+
+	Size_class &c = _classes[i];
+
+	if (c.num_blocks() >= c.target)
+		return false;
+
+	c.dirty[c.num_dirty++] = phys;
+	_request_refill();
+	return true;
+}
+
+
+void Zeroed_ram_pool::record_latency(unsigned long long cycles, bool hit)
+{
+	unsigned bucket = 0;
+	while (bucket < NUM_LATENCY_LOG2 - 1 && (cycles >> (bucket + 1)))
+		bucket++;
+
+	Lock::Guard guard(_lock);
+
+	_latency[bucket]++;
+	_num_allocs++;
+	if (hit)
+		_num_hits++;
+
+	if (_policy.report_interval && (_num_allocs % _policy.report_interval) == 0)
+		_report_latency();
+}
+
+
+Zeroed_ram_pool::Zeroed_ram_pool(Range_allocator &ram_alloc, Policy const &policy)
+:
+	Thread<4096*sizeof(long)>("zeroed_ram_pool"),
+	_ram_alloc(ram_alloc), _policy(policy), _refill_pending(false),
+	_num_allocs(0), _num_hits(0)
+{
+	memset(_latency, 0, sizeof(_latency));
+}
+
+
+void Zeroed_ram_pool::start_refill()
+{
+	start();
+
+	Lock::Guard guard(_lock);
+
+	/* distribute the capacity evenly over the size classes */
+	for (int i = 0; i < NUM_CLASSES; i++)
+		_classes[i].target = min(_policy.capacity/NUM_CLASSES/_class_size(i),
+		                         (size_t)MAX_BLOCKS);
+
+	_request_refill();
+}
@@ -0,0 +1,3 @@
+TARGET = test-allocator_stats
+SRC_CC = main.cc
+LIBS   = base
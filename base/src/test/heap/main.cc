@@ -0,0 +1,213 @@
+/*
+ * \brief  Benchmark for heap allocations contended by multiple threads
+ * \author agent
+ * \date   2026-10-17
+ *
+ * Each thread keeps 'LIVE_BLOCKS' blocks allocated and repeatedly replaces
+ * one of them by a block of random size. The benchmark reports the CPU
+ * cycles per operation for 1 to 16 threads allocating from a shared 'Heap'
+ * and from a 'Thread_cached_heap'. Finally, it checks that all memory is
+ * accounted as free after the threads are gone and that the heap returns
+ * unused dataspaces to the RAM session.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/heap.h>
+#include <base/thread.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+
+enum { MAX_THREADS = 16, LIVE_BLOCKS = 64, ROUNDS = 100000, MAX_SIZE = 1000 };
+
+
+/**
+ * Thread that allocates and frees blocks of random size
+ */
+class Worker : public Thread<4096*sizeof(long)>
+{
+	private:
+
+		Allocator    &_alloc;
+		unsigned long _seed;
+
+		void  *_blocks[LIVE_BLOCKS];
+		size_t _sizes[LIVE_BLOCKS];
+
+		size_t _random_size()
+		{
+			/* linear congruential generator */
+			_seed = _seed*1103515245 + 12345;
+			return 16 + (_seed >> 8) % (MAX_SIZE - 16);
+		}
+
+	public:
+
+		Trace::Timestamp duration;
+		bool             failed;
+
+		Worker(Allocator &alloc, unsigned id)
+		:
+			Thread("worker"), _alloc(alloc), _seed(id + 1),
+			duration(0), failed(false)
+		{ }
+
+		void entry()
+		{
+			for (unsigned i = 0; i < LIVE_BLOCKS; i++) {
+				_sizes[i] = _random_size();
+				if (!_alloc.alloc(_sizes[i], &_blocks[i])) {
+					failed = true;
+					return;
+				}
+			}
+
+			Trace::Timestamp const start = Trace::timestamp();
+
+			for (unsigned i = 0; i < ROUNDS; i++) {
+				unsigned const idx = i % LIVE_BLOCKS;
+
+				_alloc.free(_blocks[idx], _sizes[idx]);
+				_sizes[idx] = _random_size();
+				if (!_alloc.alloc(_sizes[idx], &_blocks[idx])) {
+					failed = true;
+					break;
+				}
+			}
+
+			duration = Trace::timestamp() - start;
+
+			for (unsigned i = 0; i < LIVE_BLOCKS; i++)
+				_alloc.free(_blocks[i], _sizes[i]);
+		}
+};
+
+
+static bool bench(char const *name, Allocator &alloc, unsigned num_threads)
+{
+	Worker *workers[MAX_THREADS];
+	for (unsigned i = 0; i < num_threads; i++)
+		workers[i] = new (env()->heap()) Worker(alloc, i);
+
+	for (unsigned i = 0; i < num_threads; i++)
+		workers[i]->start();
+
+	bool             failed   = false;
+	Trace::Timestamp duration = 0;
+	for (unsigned i = 0; i < num_threads; i++) {
+		workers[i]->join();
+		failed  |= workers[i]->failed;
+		duration = max(duration, workers[i]->duration);
+		destroy(env()->heap(), workers[i]);
+	}
+
+	if (failed) {
+		PERR("%s: allocation failed", name);
+		return false;
+	}
+
+	/* each round consists of one allocation and one deallocation */
+	unsigned long const ops = 2UL*ROUNDS*num_threads;
+
+	printf("%-12s threads=%2u  %6lu cycles/op  %8lu ops/Mcycle\n",
+	       name, num_threads, (unsigned long)(duration*num_threads/ops),
+	       (unsigned long)(ops*1000000/duration));
+	return true;
+}
+
+
+/**
+ * Check the release of unused backing-store dataspaces
+ */
+static bool test_release()
+{
+	enum { NUM_BLOCKS = 4096, BLOCK_SIZE = 4000 };
+	static void *blocks[NUM_BLOCKS];
+
+	Ram_session &ram = *env()->ram_session();
+	size_t const used_before = ram.used();
+	{
+		Heap heap(&ram, env()->rm_session());
+
+		for (unsigned i = 0; i < NUM_BLOCKS; i++)
+			if (!heap.alloc(BLOCK_SIZE, &blocks[i])) {
+				PERR("allocation %u failed", i);
+				return false;
+			}
+
+		size_t const used_peak = ram.used();
+
+		for (unsigned i = 0; i < NUM_BLOCKS; i++)
+			heap.free(blocks[i], BLOCK_SIZE);
+
+		size_t const used_freed = ram.used();
+
+		heap.unused_limit(0);
+
+		size_t const used_final = ram.used();
+
+		printf("RAM used by heap: peak %zu, freed %zu, no unused %zu bytes\n",
+		       used_peak - used_before, used_freed - used_before,
+		       used_final - used_before);
+
+		if (used_freed - used_before > Heap::DEFAULT_UNUSED_LIMIT + 64*1024) {
+			PERR("heap keeps too many unused dataspaces");
+			return false;
+		}
+
+		/* at most one chunk of meta data is retained */
+		if (used_final - used_before > 64*1024) {
+			PERR("heap did not release unused dataspaces");
+			return false;
+		}
+	}
+	return true;
+}
+
+
+int main(int, char **)
+{
+	printf("--- heap benchmark started ---\n");
+
+	static Heap heap(env()->ram_session(), env()->rm_session());
+
+	for (unsigned n = 1; n <= MAX_THREADS; n *= 2)
+		if (!bench("heap", heap, n))
+			return -1;
+
+	{
+		Thread_cached_heap cached_heap(heap);
+
+		for (unsigned n = 1; n <= MAX_THREADS; n *= 2)
+			if (!bench("cached heap", cached_heap, n))
+				return -1;
+
+		/* the caches of the destructed threads must not count as consumed */
+		if (cached_heap.consumed() != 0) {
+			PERR("cached heap consumed %zu bytes after test", cached_heap.consumed());
+			return -1;
+		}
+	}
+
+	/* all cached blocks must have been returned to the backing heap */
+	if (heap.consumed() != 0) {
+		PERR("heap consumed %zu bytes after test", heap.consumed());
+		return -1;
+	}
+
+	if (!test_release())
+		return -1;
+
+	printf("--- heap benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,410 @@
+/*
+ * \brief  Microbenchmarks for IPC, RPC, signals, and locks
+ * \author agent
+ * \date   2026-10-17
+ *
+ * Each benchmark measures the CPU cycles of a number of individual
+ * operations and reports the median, the 90th and 99th percentile, and the
+ * maximum. The following operations are measured:
+ *
+ * - Round trip of an RPC call without arguments
+ * - Round trip of an RPC call with a 512-byte 'Rpc_in_buffer' argument,
+ *   which fits into the 1 KiB receive buffer of 'Rpc_entrypoint'
+ * - Round trip of RPC calls passing 1 to 4 capabilities
+ * - Latency from submitting a signal to the wakeup of the receiver
+ * - Acquisition and release of a 'Lock' contended by 1, 2, and 4 threads
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/thread.h>
+#include <base/signal.h>
+#include <base/snprintf.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <cap_session/connection.h>
+#include <trace/timestamp.h>
+
+
+/*******************
+ ** RPC interface **
+ *******************/
+
+namespace Test {
+
+	struct Bench
+	{
+		typedef Genode::Rpc_in_buffer<512>  Buffer;
+		typedef Genode::Capability<Bench>   Cap;
+
+		virtual void empty() = 0;
+		virtual void buffer(Buffer const &) = 0;
+		virtual void caps_1(Cap) = 0;
+		virtual void caps_2(Cap, Cap) = 0;
+		virtual void caps_3(Cap, Cap, Cap) = 0;
+		virtual void caps_4(Cap, Cap, Cap, Cap) = 0;
+
+		GENODE_RPC(Rpc_empty, void, empty);
+		GENODE_RPC(Rpc_buffer, void, buffer, Buffer const &);
+		GENODE_RPC(Rpc_caps_1, void, caps_1, Cap);
+		GENODE_RPC(Rpc_caps_2, void, caps_2, Cap, Cap);
+		GENODE_RPC(Rpc_caps_3, void, caps_3, Cap, Cap, Cap);
+		GENODE_RPC(Rpc_caps_4, void, caps_4, Cap, Cap, Cap, Cap);
+		GENODE_RPC_INTERFACE(Rpc_empty, Rpc_buffer, Rpc_caps_1, Rpc_caps_2,
+		                     Rpc_caps_3, Rpc_caps_4);
+	};
+
+
+	struct Bench_component : Genode::Rpc_object<Bench, Bench_component>
+	{
+		void empty() { }
+		void buffer(Buffer const &) { }
+		void caps_1(Cap) { }
+		void caps_2(Cap, Cap) { }
+		void caps_3(Cap, Cap, Cap) { }
+		void caps_4(Cap, Cap, Cap, Cap) { }
+	};
+
+
+	struct Bench_client : Genode::Rpc_client<Bench>
+	{
+		Bench_client(Genode::Capability<Bench> cap)
+		: Genode::Rpc_client<Bench>(cap) { }
+
+		void empty() { call<Rpc_empty>(); }
+		void buffer(Buffer const &b) { call<Rpc_buffer>(b); }
+		void caps_1(Cap a) { call<Rpc_caps_1>(a); }
+		void caps_2(Cap a, Cap b) { call<Rpc_caps_2>(a, b); }
+		void caps_3(Cap a, Cap b, Cap c) { call<Rpc_caps_3>(a, b, c); }
+		void caps_4(Cap a, Cap b, Cap c, Cap d) { call<Rpc_caps_4>(a, b, c, d); }
+	};
+}
+
+
+/*************
+ ** Samples **
+ *************/
+
+using namespace Genode;
+
+enum { WARMUP_ROUNDS = 1000, ROUNDS = 10000 };
+
+
+/**
+ * Measured durations of individual operations
+ */
+class Samples
+{
+	private:
+
+		unsigned const    _capacity;
+		Trace::Timestamp *_values;
+		unsigned          _count;
+
+		void _sort()
+		{
+			/* shell sort with gaps 3x+1 */
+			unsigned gap = 1;
+			while (gap < _count/3) gap = 3*gap + 1;
+
+			for (; gap > 0; gap /= 3)
+				for (unsigned i = gap; i < _count; i++) {
+					Trace::Timestamp const v = _values[i];
+					unsigned j = i;
+					for (; j >= gap && _values[j - gap] > v; j -= gap)
+						_values[j] = _values[j - gap];
+					_values[j] = v;
+				}
+		}
+
+		unsigned long _percentile(unsigned p) const {
+			return (unsigned long)_values[((_count - 1)*p)/100]; }
+
+	public:
+
+		Samples(unsigned capacity = ROUNDS)
+		:
+			_capacity(capacity),
+			_values((Trace::Timestamp *)env()->heap()->alloc(capacity*sizeof(Trace::Timestamp))),
+			_count(0)
+		{ }
+
+		~Samples() { env()->heap()->free(_values, _capacity*sizeof(Trace::Timestamp)); }
+
+		void add(Trace::Timestamp value)
+		{
+			if (_count < _capacity)
+				_values[_count++] = value;
+		}
+
+		void add(Samples const &other)
+		{
+			for (unsigned i = 0; i < other._count; i++)
+				add(other._values[i]);
+		}
+
+		/**
+		 * Print percentiles in CPU cycles
+		 */
+		void print(char const *name)
+		{
+			if (!_count)
+				return;
+
+			_sort();
+
+			printf("%-20s samples=%5u  p50=%6lu  p90=%6lu  p99=%6lu  max=%8lu cycles\n",
+			       name, _count, _percentile(50), _percentile(90),
+			       _percentile(99), (unsigned long)_values[_count - 1]);
+		}
+};
+
+
+/**
+ * Measure 'ROUNDS' executions of 'op' after 'WARMUP_ROUNDS' executions
+ */
+template <typename FUNC>
+static void measure(char const *name, FUNC const &op)
+{
+	/* populate caches and let lazily created resources come into existence */
+	for (unsigned i = 0; i < WARMUP_ROUNDS; i++)
+		op();
+
+	Samples samples;
+
+	for (unsigned i = 0; i < ROUNDS; i++) {
+		Trace::Timestamp const start = Trace::timestamp();
+		op();
+		samples.add(Trace::timestamp() - start);
+	}
+
+	samples.print(name);
+}
+
+
+/*********
+ ** RPC **
+ *********/
+
+typedef Test::Bench::Cap Cap;
+
+struct Empty_op
+{
+	Test::Bench_client &client;
+	Empty_op(Test::Bench_client &client) : client(client) { }
+	void operator () () const { client.empty(); }
+};
+
+
+struct Buffer_op
+{
+	Test::Bench_client        &client;
+	Test::Bench::Buffer const &buffer;
+	Buffer_op(Test::Bench_client &client, Test::Bench::Buffer const &buffer)
+	: client(client), buffer(buffer) { }
+	void operator () () const { client.buffer(buffer); }
+};
+
+
+struct Caps_op
+{
+	Test::Bench_client &client;
+	Cap const           cap;
+	unsigned const      num_caps;
+	Caps_op(Test::Bench_client &client, Cap cap, unsigned num_caps)
+	: client(client), cap(cap), num_caps(num_caps) { }
+	void operator () () const
+	{
+		switch (num_caps) {
+		case 1: client.caps_1(cap); break;
+		case 2: client.caps_2(cap, cap); break;
+		case 3: client.caps_3(cap, cap, cap); break;
+		case 4: client.caps_4(cap, cap, cap, cap); break;
+		}
+	}
+};
+
+
+static void bench_rpc(Rpc_entrypoint &ep)
+{
+	static Test::Bench_component component;
+	Cap const cap = ep.manage(&component);
+	Test::Bench_client client(cap);
+
+	measure("empty RPC", Empty_op(client));
+
+	static char data[Test::Bench::Buffer::MAX_SIZE];
+	for (unsigned i = 0; i < sizeof(data); i++)
+		data[i] = i;
+	static Test::Bench::Buffer buffer(data, sizeof(data));
+
+	measure("512 B Rpc_in_buffer", Buffer_op(client, buffer));
+
+	measure("RPC with 1 cap",  Caps_op(client, cap, 1));
+	measure("RPC with 2 caps", Caps_op(client, cap, 2));
+	measure("RPC with 3 caps", Caps_op(client, cap, 3));
+	measure("RPC with 4 caps", Caps_op(client, cap, 4));
+
+	ep.dissolve(&component);
+}
+
+
+/*************
+ ** Signals **
+ *************/
+
+/**
+ * Thread that measures the time from the submission of a signal to its
+ * own wakeup
+ */
+class Signal_handler_thread : public Thread<4096*sizeof(long)>
+{
+	private:
+
+		Signal_receiver            _receiver;
+		Signal_context             _context;
+		Signal_context_capability  _cap;
+
+	public:
+
+		Trace::Timestamp volatile submit_time;
+		Lock                      handled;
+		Samples                   samples;
+
+		Signal_handler_thread()
+		:
+			Thread("signal_handler"), _cap(_receiver.manage(&_context)),
+			submit_time(0), handled(Lock::LOCKED)
+		{ }
+
+		~Signal_handler_thread() { _receiver.dissolve(&_context); }
+
+		Signal_context_capability cap() const { return _cap; }
+
+		void entry()
+		{
+			for (unsigned i = 0; i < WARMUP_ROUNDS + ROUNDS; i++) {
+				_receiver.wait_for_signal();
+
+				if (i >= WARMUP_ROUNDS)
+					samples.add(Trace::timestamp() - submit_time);
+
+				handled.unlock();
+			}
+		}
+};
+
+
+static void bench_signal()
+{
+	Signal_handler_thread *handler = new (env()->heap()) Signal_handler_thread;
+	handler->start();
+
+	Signal_transmitter transmitter(handler->cap());
+
+	for (unsigned i = 0; i < WARMUP_ROUNDS + ROUNDS; i++) {
+		handler->submit_time = Trace::timestamp();
+		transmitter.submit();
+		handler->handled.lock();
+	}
+
+	handler->join();
+	handler->samples.print("signal latency");
+	destroy(env()->heap(), handler);
+}
+
+
+/***********
+ ** Locks **
+ ***********/
+
+/**
+ * Thread that repeatedly acquires and releases a shared lock
+ */
+class Contender : public Thread<4096*sizeof(long)>
+{
+	private:
+
+		Lock          &_lock;
+		unsigned long &_counter;
+
+	public:
+
+		Samples samples;
+
+		Contender(Lock &lock, unsigned long &counter)
+		: Thread("contender"), _lock(lock), _counter(counter) { }
+
+		void entry()
+		{
+			for (unsigned i = 0; i < WARMUP_ROUNDS + ROUNDS; i++) {
+
+				Trace::Timestamp const start = Trace::timestamp();
+				{
+					Lock::Guard guard(_lock);
+					_counter++;
+				}
+				if (i >= WARMUP_ROUNDS)
+					samples.add(Trace::timestamp() - start);
+			}
+		}
+};
+
+
+static void bench_lock(unsigned num_threads)
+{
+	enum { MAX_THREADS = 4 };
+
+	static Lock          lock;
+	static unsigned long counter;
+
+	Contender *contenders[MAX_THREADS];
+	for (unsigned i = 0; i < num_threads; i++)
+		contenders[i] = new (env()->heap()) Contender(lock, counter);
+
+	for (unsigned i = 0; i < num_threads; i++)
+		contenders[i]->start();
+
+	Samples samples(num_threads*ROUNDS);
+	for (unsigned i = 0; i < num_threads; i++) {
+		contenders[i]->join();
+		samples.add(contenders[i]->samples);
+		destroy(env()->heap(), contenders[i]);
+	}
+
+	char name[32];
+	snprintf(name, sizeof(name), "lock, %u thread%s", num_threads,
+	         num_threads > 1 ? "s" : "");
+	samples.print(name);
+}
+
+
+/**********
+ ** Main **
+ **********/
+
+int main(int, char **)
+{
+	printf("--- IPC benchmark started ---\n");
+
+	enum { STACK_SIZE = 4096*sizeof(long) };
+	static Cap_connection cap;
+	static Rpc_entrypoint ep(&cap, STACK_SIZE, "bench_ep");
+
+	bench_rpc(ep);
+	bench_signal();
+	bench_lock(1);
+	bench_lock(2);
+	bench_lock(4);
+
+	printf("--- IPC benchmark finished ---\n");
+	return 0;
+}
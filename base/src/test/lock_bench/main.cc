@@ -0,0 +1,117 @@
+/*
+ * \brief  Benchmark of the lock under contention
+ * \author agent
+ * \date   2026-10-17
+ *
+ * A number of threads repeatedly enter a short critical section protected
+ * by one lock. For each number of threads, the benchmark reports the
+ * duration of the whole run and the average costs per lock acquisition in
+ * CPU cycles. The result of the shared counter is checked to detect broken
+ * mutual exclusion.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+typedef Trace::Timestamp Timestamp;
+
+
+enum { MAX_THREADS = 16, ROUNDS_PER_THREAD = 100000, STACK_SIZE = 4096*sizeof(long) };
+
+
+static Lock          lock;
+static unsigned long volatile counter;
+
+
+class Contender : public Thread<STACK_SIZE>
+{
+	private:
+
+		Semaphore &_start;
+		Semaphore &_done;
+
+	public:
+
+		Contender(Semaphore &start, Semaphore &done)
+		: Thread<STACK_SIZE>("contender"), _start(start), _done(done) { }
+
+		void entry()
+		{
+			_start.down();
+
+			for (unsigned i = 0; i < ROUNDS_PER_THREAD; i++) {
+				Lock::Guard guard(lock);
+
+				/* keep the critical section short but not empty */
+				counter = counter + 1;
+			}
+
+			_done.up();
+		}
+};
+
+
+static bool measure(unsigned num_threads)
+{
+	static Semaphore start, done;
+
+	Contender *contender[MAX_THREADS];
+	for (unsigned i = 0; i < num_threads; i++) {
+		contender[i] = new (env()->heap()) Contender(start, done);
+		contender[i]->start();
+	}
+
+	counter = 0;
+	Timestamp const t0 = Trace::timestamp();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		start.up();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		done.down();
+
+	Timestamp const duration = Trace::timestamp() - t0;
+
+	for (unsigned i = 0; i < num_threads; i++)
+		destroy(env()->heap(), contender[i]);
+
+	unsigned long const expected = (unsigned long)num_threads*ROUNDS_PER_THREAD;
+
+	printf("threads=%2u acquisitions=%lu total=%llu cycles, %llu cycles per acquisition\n",
+	       num_threads, expected, (unsigned long long)duration,
+	       (unsigned long long)(duration/expected));
+
+	if (counter != expected) {
+		PERR("counter is %lu, expected %lu", counter, expected);
+		return false;
+	}
+	return true;
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- lock benchmark started ---\n");
+
+	static unsigned const num_threads[] = { 1, 2, 4, 8, 16 };
+
+	for (unsigned i = 0; i < sizeof(num_threads)/sizeof(num_threads[0]); i++)
+		if (!measure(num_threads[i]))
+			return -1;
+
+	printf("--- lock benchmark finished ---\n");
+	return 0;
+}
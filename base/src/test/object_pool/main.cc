@@ -0,0 +1,131 @@
+/*
+ * \brief  Benchmark for object-pool lookups
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark populates an object pool with 10, 1000, and 100000 objects
+ * and reports the throughput of 'lookup_and_lock' for one thread and for
+ * four threads looking up objects concurrently.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/thread.h>
+#include <base/object_pool.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+
+struct Object : Object_pool<Object>::Entry
+{
+	Object(unsigned long id)
+	: Object_pool<Object>::Entry(Native_capability(Native_capability::Dst(), id)) { }
+};
+
+
+enum { LOOKUPS_PER_THREAD = 1000000, MAX_THREADS = 4 };
+
+
+/**
+ * Look up 'LOOKUPS_PER_THREAD' objects with ids in the range 1..'num_objects'
+ */
+static void lookup_objects(Object_pool<Object> &pool, unsigned long num_objects,
+                           unsigned long seed)
+{
+	unsigned long id = seed;
+	for (unsigned i = 0; i < LOOKUPS_PER_THREAD; i++) {
+
+		/* linear congruential generator to visit the objects in random order */
+		id = id*1103515245 + 12345;
+
+		Object_pool<Object>::Guard obj(pool.lookup_and_lock(1 + id % num_objects));
+		if (!obj)
+			PERR("lookup of object %lu failed", 1 + id % num_objects);
+	}
+}
+
+
+class Lookup_thread : public Thread<4096*sizeof(long)>
+{
+	private:
+
+		Object_pool<Object> &_pool;
+		unsigned long const  _num_objects;
+		unsigned long const  _seed;
+
+	public:
+
+		Lookup_thread(Object_pool<Object> &pool, unsigned long num_objects,
+		              unsigned long seed)
+		:
+			Thread("lookup"), _pool(pool), _num_objects(num_objects), _seed(seed)
+		{ }
+
+		void entry() { lookup_objects(_pool, _num_objects, _seed); }
+};
+
+
+static void measure(Object_pool<Object> &pool, unsigned long num_objects,
+                    unsigned num_threads)
+{
+	Lookup_thread *threads[MAX_THREADS];
+	for (unsigned i = 0; i < num_threads; i++)
+		threads[i] = new (env()->heap()) Lookup_thread(pool, num_objects, i);
+
+	Trace::Timestamp const start = Trace::timestamp();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		threads[i]->start();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		threads[i]->join();
+
+	Trace::Timestamp const cycles = Trace::timestamp() - start;
+
+	unsigned long const lookups = (unsigned long)num_threads*LOOKUPS_PER_THREAD;
+	unsigned long const mcycles = (unsigned long)(cycles / 1000000);
+
+	printf("%6lu objects, %u threads: %lu lookups per Mcycle\n",
+	       num_objects, num_threads, mcycles ? lookups / mcycles : 0);
+
+	for (unsigned i = 0; i < num_threads; i++)
+		destroy(env()->heap(), threads[i]);
+}
+
+
+int main(int, char **)
+{
+	printf("--- object-pool benchmark started ---\n");
+
+	static unsigned long const object_counts[] = { 10, 1000, 100000 };
+
+	for (unsigned i = 0; i < sizeof(object_counts)/sizeof(object_counts[0]); i++) {
+
+		unsigned long const num_objects = object_counts[i];
+
+		static Object_pool<Object> pool;
+
+		for (unsigned long id = 1; id <= num_objects; id++)
+			pool.insert(new (env()->heap()) Object(id));
+
+		measure(pool, num_objects, 1);
+		measure(pool, num_objects, MAX_THREADS);
+
+		while (Object *obj = pool.first()) {
+			pool.remove_locked(obj);
+			destroy(env()->heap(), obj);
+		}
+	}
+
+	printf("--- object-pool benchmark finished ---\n");
+	return 0;
+}
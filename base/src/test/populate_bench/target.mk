@@ -0,0 +1,3 @@
+TARGET = test-populate_bench
+SRC_CC = main.cc
+LIBS   = base
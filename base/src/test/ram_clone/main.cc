@@ -0,0 +1,79 @@
+/*
+ * \brief  Test for cloning RAM dataspaces
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <base/env.h>
+#include <base/printf.h>
+#include <dataspace/client.h>
+
+using namespace Genode;
+
+
+enum { DS_SIZE = 1024*1024, PAGE_SIZE = 4096 };
+
+
+/**
+ * Return value expected at the given page of the original dataspace
+ */
+static unsigned pattern(unsigned page) { return 0x5a5a0000 + page; }
+
+
+int main(int argc, char **argv)
+{
+	printf("--- dataspace cloning test started ---\n");
+
+	Ram_dataspace_capability ds = env()->ram_session()->alloc(DS_SIZE);
+	unsigned *src = env()->rm_session()->attach(ds);
+
+	/* populate every other page only, the remaining pages stay zero */
+	for (unsigned page = 0; page < DS_SIZE/PAGE_SIZE; page += 2)
+		src[page*PAGE_SIZE/sizeof(unsigned)] = pattern(page);
+
+	Ram_dataspace_capability clone = env()->ram_session()->clone(ds);
+	if (!clone.valid()) {
+		printf("cloning is not supported on this platform\n");
+		printf("--- dataspace cloning test finished ---\n");
+		return 0;
+	}
+
+	if (Dataspace_client(clone).size() != DS_SIZE) {
+		PERR("clone has wrong size");
+		return -1;
+	}
+
+	unsigned *dst = env()->rm_session()->attach(clone);
+
+	for (unsigned page = 0; page < DS_SIZE/PAGE_SIZE; page++) {
+		unsigned const expected = (page & 1) ? 0 : pattern(page);
+		if (dst[page*PAGE_SIZE/sizeof(unsigned)] != expected) {
+			PERR("clone differs from original at page %u", page);
+			return -2;
+		}
+	}
+
+	/* the clone and the original must be independent of each other */
+	src[0] = 0;
+	dst[PAGE_SIZE/sizeof(unsigned)] = 1;
+
+	if (dst[0] != pattern(0) || src[PAGE_SIZE/sizeof(unsigned)] != 0) {
+		PERR("clone is not independent from original");
+		return -3;
+	}
+
+	env()->rm_session()->detach(dst);
+	env()->rm_session()->detach(src);
+	env()->ram_session()->free(clone);
+	env()->ram_session()->free(ds);
+
+	printf("--- dataspace cloning test finished ---\n");
+	return 0;
+}
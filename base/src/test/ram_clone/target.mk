@@ -0,0 +1,3 @@
+TARGET = test-ram_clone
+SRC_CC = main.cc
+LIBS   = base
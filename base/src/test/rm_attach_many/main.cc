@@ -0,0 +1,89 @@
+/*
+ * \brief  Test for attaching and detaching regions in batches
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <base/env.h>
+#include <base/printf.h>
+#include <rm_session/connection.h>
+
+using namespace Genode;
+
+
+enum { PAGE_SIZE = 4096, NUM_PAGES = 4 };
+
+
+int main(int argc, char **argv)
+{
+	printf("--- batched attach test started ---\n");
+
+	Ram_dataspace_capability ds = env()->ram_session()->alloc(NUM_PAGES*PAGE_SIZE);
+
+	/* mark each page of the dataspace with its index */
+	unsigned *local = env()->rm_session()->attach(ds);
+	for (unsigned i = 0; i < NUM_PAGES; i++)
+		local[i*PAGE_SIZE/sizeof(unsigned)] = i;
+
+	/* attach the pages in reverse order, each one separately */
+	Rm_session::Attachment_batch batch;
+	for (unsigned i = 0; i < NUM_PAGES; i++)
+		batch.add(Rm_session::Attachment(PAGE_SIZE, (NUM_PAGES - 1 - i)*PAGE_SIZE));
+
+	Rm_session::Local_addr_batch addrs = env()->rm_session()->attach_many(ds, batch);
+
+	if (addrs.count != NUM_PAGES) {
+		PERR("attach_many returned %u instead of %u addresses",
+		     addrs.count, (unsigned)NUM_PAGES);
+		return -1;
+	}
+
+	for (unsigned i = 0; i < NUM_PAGES; i++) {
+		unsigned const value = *(unsigned *)addrs.addr[i];
+		if (value != NUM_PAGES - 1 - i) {
+			PERR("region %u refers to page %u", i, value);
+			return -2;
+		}
+	}
+
+	env()->rm_session()->detach_many(addrs);
+
+	/*
+	 * A batch with a conflicting region must leave the RM session
+	 * untouched. We use a dedicated RM session to obtain predictable
+	 * addresses.
+	 */
+	Rm_connection rm(0, 16*PAGE_SIZE);
+
+	Rm_session::Attachment_batch conflict;
+	conflict.add(Rm_session::Attachment(PAGE_SIZE, 0, true, 0));
+	conflict.add(Rm_session::Attachment(PAGE_SIZE, 0, true, PAGE_SIZE));
+	conflict.add(Rm_session::Attachment(PAGE_SIZE, 0, true, 0));
+
+	try {
+		rm.attach_many(ds, conflict);
+		PERR("conflicting batch was not rejected");
+		return -3;
+	} catch (Rm_session::Region_conflict) { }
+
+	try {
+		rm.attach_at(ds, 0, PAGE_SIZE);
+		rm.attach_at(ds, PAGE_SIZE, PAGE_SIZE);
+	} catch (Rm_session::Attach_failed) {
+		PERR("regions of rejected batch were not detached");
+		return -4;
+	}
+
+	env()->rm_session()->detach(local);
+	env()->ram_session()->free(ds);
+
+	printf("--- batched attach test finished ---\n");
+	return 0;
+}
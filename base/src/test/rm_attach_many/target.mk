@@ -0,0 +1,3 @@
+TARGET = test-rm_attach_many
+SRC_CC = main.cc
+LIBS   = base
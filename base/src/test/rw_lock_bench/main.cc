@@ -0,0 +1,185 @@
+/*
+ * \brief  Benchmark of reader scaling of the reader-writer lock
+ * \author agent
+ * \date   2026-10-17
+ *
+ * A number of threads look up entries of a table protected by a lock. Every
+ * 64th operation of a thread modifies the table. The benchmark runs with a
+ * plain 'Lock' and with a 'Rw_lock' and reports the duration of each run in
+ * CPU cycles. The modifications keep two table entries in sync. Readers
+ * check them to detect broken mutual exclusion.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <base/rw_lock.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+typedef Trace::Timestamp Timestamp;
+
+
+enum {
+	MAX_THREADS  = 16,
+	OPS          = 20000,  /* operations per thread */
+	WRITE_PERIOD = 64,     /* every n-th operation is a write */
+	TABLE_SIZE   = 256,
+	STACK_SIZE   = 4096*sizeof(long)
+};
+
+
+static unsigned long volatile table[TABLE_SIZE];
+static bool volatile          broken;
+
+
+static void read_table()
+{
+	/* look up the largest entry, mimicking the search of a registry */
+	unsigned long max = 0;
+	for (unsigned i = 0; i < TABLE_SIZE; i++)
+		if (table[i] > max)
+			max = table[i];
+
+	if (table[0] != table[TABLE_SIZE - 1] || max != table[0])
+		broken = true;
+}
+
+
+static void write_table()
+{
+	table[0]++;
+	table[TABLE_SIZE - 1]++;
+}
+
+
+/**
+ * Lock policies used by the benchmark
+ */
+struct Exclusive
+{
+	static char const *name() { return "Lock   "; }
+
+	Lock lock;
+
+	void read()  { Lock::Guard guard(lock); read_table(); }
+	void write() { Lock::Guard guard(lock); write_table(); }
+};
+
+
+struct Shared
+{
+	static char const *name() { return "Rw_lock"; }
+
+	Rw_lock lock;
+
+	void read()  { Rw_lock::Read_guard  guard(lock); read_table(); }
+	void write() { Rw_lock::Write_guard guard(lock); write_table(); }
+};
+
+
+template <typename POLICY>
+class Worker : public Thread<STACK_SIZE>
+{
+	private:
+
+		POLICY    &_policy;
+		Semaphore &_start;
+		Semaphore &_done;
+
+	public:
+
+		Worker(POLICY &policy, Semaphore &start, Semaphore &done)
+		:
+			Thread<STACK_SIZE>("worker"),
+			_policy(policy), _start(start), _done(done)
+		{ }
+
+		void entry()
+		{
+			_start.down();
+
+			for (unsigned i = 0; i < OPS; i++)
+				if (i % WRITE_PERIOD == 0)
+					_policy.write();
+				else
+					_policy.read();
+
+			_done.up();
+		}
+};
+
+
+template <typename POLICY>
+static Timestamp measure(unsigned num_threads)
+{
+	static POLICY    policy;
+	static Semaphore start, done;
+
+	Worker<POLICY> *worker[MAX_THREADS];
+	for (unsigned i = 0; i < num_threads; i++) {
+		worker[i] = new (env()->heap()) Worker<POLICY>(policy, start, done);
+		worker[i]->start();
+	}
+
+	Timestamp const t0 = Trace::timestamp();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		start.up();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		done.down();
+
+	Timestamp const duration = Trace::timestamp() - t0;
+
+	for (unsigned i = 0; i < num_threads; i++)
+		destroy(env()->heap(), worker[i]);
+
+	printf("%s threads=%2u total=%llu cycles, %llu cycles per operation\n",
+	       POLICY::name(), num_threads, (unsigned long long)duration,
+	       (unsigned long long)(duration/((unsigned long)num_threads*OPS)));
+
+	return duration;
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- rw_lock benchmark started ---\n");
+
+	static unsigned const num_threads[] = { 1, 2, 4, 8, 16 };
+
+	for (unsigned i = 0; i < sizeof(num_threads)/sizeof(num_threads[0]); i++) {
+		measure<Exclusive>(num_threads[i]);
+		measure<Shared>(num_threads[i]);
+	}
+
+	/* upgrade from read to write access */
+	{
+		Rw_lock lock;
+		lock.lock_read();
+		if (!lock.upgrade()) {
+			PERR("upgrade of sole reader failed");
+			return -1;
+		}
+		lock.unlock_write();
+	}
+
+	if (broken) {
+		PERR("readers observed inconsistent table");
+		return -1;
+	}
+
+	printf("--- rw_lock benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-rw_lock_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,102 @@
+/*
+ * \brief  Benchmark for the slab allocator
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark reports the CPU cycles per operation for filling a slab
+ * with 'NUM_ENTRIES' entries, for randomly freeing and re-allocating
+ * entries of the filled slab, and for freeing all entries. Each workload is
+ * executed for different entry and block sizes.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/slab.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+
+enum { NUM_ENTRIES = 20000, CHURN_ROUNDS = 200000 };
+
+
+static unsigned long per_op(Trace::Timestamp cycles, unsigned long ops) {
+	return (unsigned long)(cycles / ops); }
+
+
+static void bench(size_t entry_size, size_t block_size, void **entries)
+{
+	Slab slab(entry_size, block_size, 0, env()->heap());
+
+	/* fill slab */
+	Trace::Timestamp start = Trace::timestamp();
+	for (unsigned i = 0; i < NUM_ENTRIES; i++)
+		if (!slab.alloc(entry_size, &entries[i])) {
+			PERR("allocation %u failed", i);
+			return;
+		}
+	Trace::Timestamp const fill = Trace::timestamp() - start;
+
+	/* free and re-allocate entries in random order */
+	unsigned long r = 1;
+	start = Trace::timestamp();
+	for (unsigned i = 0; i < CHURN_ROUNDS; i++) {
+
+		/* linear congruential generator */
+		r = r*1103515245 + 12345;
+		unsigned const idx = (r >> 8) % NUM_ENTRIES;
+
+		slab.free(entries[idx], entry_size);
+		if (!slab.alloc(entry_size, &entries[idx])) {
+			PERR("re-allocation %u failed", i);
+			return;
+		}
+	}
+	Trace::Timestamp const churn = Trace::timestamp() - start;
+
+	size_t const consumed = slab.consumed();
+
+	/* free all entries, starting with every other entry to fragment blocks */
+	start = Trace::timestamp();
+	for (unsigned i = 0; i < NUM_ENTRIES; i += 2)
+		slab.free(entries[i], entry_size);
+	for (unsigned i = 1; i < NUM_ENTRIES; i += 2)
+		slab.free(entries[i], entry_size);
+	Trace::Timestamp const drain = Trace::timestamp() - start;
+
+	if (slab.first_used_elem())
+		PERR("slab has used entries after freeing all entries");
+
+	printf("entry %4zu, block %6zu: alloc %5lu  churn %5lu  free %5lu cycles, "
+	       "%zu KiB\n", entry_size, block_size,
+	       per_op(fill, NUM_ENTRIES), per_op(churn, 2*CHURN_ROUNDS),
+	       per_op(drain, NUM_ENTRIES), consumed/1024);
+}
+
+
+int main(int, char **)
+{
+	printf("--- slab benchmark started ---\n");
+
+	void **entries = (void **)env()->heap()->alloc(NUM_ENTRIES*sizeof(void *));
+
+	static size_t const entry_sizes[] = { 16, 64, 256 };
+	static size_t const block_sizes[] = { 4096, 65536 };
+
+	for (unsigned i = 0; i < sizeof(entry_sizes)/sizeof(entry_sizes[0]); i++)
+		for (unsigned j = 0; j < sizeof(block_sizes)/sizeof(block_sizes[0]); j++)
+			bench(entry_sizes[i], block_sizes[j], entries);
+
+	env()->heap()->free(entries, NUM_ENTRIES*sizeof(void *));
+
+	printf("--- slab benchmark finished ---\n");
+	return 0;
+}
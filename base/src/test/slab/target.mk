@@ -0,0 +1,3 @@
+TARGET = test-slab
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,114 @@
+/*
+ * \brief  Benchmark of thread creation and destruction
+ * \author agent
+ * \date   2026-10-17
+ *
+ * Threads with an empty entry function are created, started, joined, and
+ * destroyed in batches of different sizes. For each batch size, the
+ * benchmark reports the average costs of each step in CPU cycles. Batches
+ * larger than the number of thread contexts cached by the thread library
+ * show the costs of creating threads without recycled contexts.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/thread.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+typedef Trace::Timestamp Timestamp;
+
+
+enum { MAX_BATCH = 32, ROUNDS = 200, STACK_SIZE = 4096*sizeof(long) };
+
+
+static unsigned long volatile executed;
+
+
+struct Worker : Thread<STACK_SIZE>
+{
+	Worker() : Thread<STACK_SIZE>("worker") { }
+
+	void entry() { executed = executed + 1; }
+};
+
+
+struct Costs
+{
+	Timestamp create, start, join, destroy;
+
+	Costs() : create(0), start(0), join(0), destroy(0) { }
+};
+
+
+static void measure(unsigned batch)
+{
+	Costs   costs;
+	Worker *worker[MAX_BATCH];
+
+	executed = 0;
+
+	for (unsigned r = 0; r < ROUNDS; r++) {
+
+		Timestamp t = Trace::timestamp();
+
+		for (unsigned i = 0; i < batch; i++)
+			worker[i] = new (env()->heap()) Worker();
+
+		Timestamp now = Trace::timestamp();
+		costs.create += now - t; t = now;
+
+		for (unsigned i = 0; i < batch; i++)
+			worker[i]->start();
+
+		now = Trace::timestamp();
+		costs.start += now - t; t = now;
+
+		for (unsigned i = 0; i < batch; i++)
+			worker[i]->join();
+
+		now = Trace::timestamp();
+		costs.join += now - t; t = now;
+
+		for (unsigned i = 0; i < batch; i++)
+			destroy(env()->heap(), worker[i]);
+
+		now = Trace::timestamp();
+		costs.destroy += now - t;
+	}
+
+	unsigned long long const n = (unsigned long long)ROUNDS*batch;
+
+	printf("batch=%2u threads=%llu cycles per thread: create=%llu start=%llu "
+	       "join=%llu destroy=%llu total=%llu\n", batch, n,
+	       (unsigned long long)costs.create/n, (unsigned long long)costs.start/n,
+	       (unsigned long long)costs.join/n, (unsigned long long)costs.destroy/n,
+	       (unsigned long long)(costs.create + costs.start + costs.join
+	                            + costs.destroy)/n);
+
+	if (executed != n)
+		PERR("%lu threads executed, expected %llu", executed, n);
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- thread-creation benchmark started ---\n");
+
+	static unsigned const batch[] = { 1, 4, 8, 16, 32 };
+
+	for (unsigned i = 0; i < sizeof(batch)/sizeof(batch[0]); i++)
+		measure(batch[i]);
+
+	printf("--- thread-creation benchmark finished ---\n");
+	return 0;
+}
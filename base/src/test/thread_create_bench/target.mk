@@ -0,0 +1,3 @@
+TARGET = test-thread_create_bench
+SRC_CC = main.cc
+LIBS   = base
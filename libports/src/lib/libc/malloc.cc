@@ -1,8 +1,26 @@
 /*
- * \brief  Simplistic malloc and free implementation
+ * \brief  malloc and free implementation
  * \author Norman Feske
  * \author Sebastian Sumpf
  * \date   2006-07-21
+ *
+ * The allocator consists of three tiers:
+ *
+ * - Small blocks are rounded up to one of the size classes of
+ *   'Genode::Thread_cached_heap', which are spaced by a factor of 1.5.
+ *   Each thread caches freed blocks in magazines, so most small
+ *   allocations do not acquire any lock. The backing store of the caches
+ *   is a slab allocator per size class.
+ *
+ * - Medium blocks are allocated from the heap of the environment.
+ *
+ * - Large blocks of at least 'LARGE_BLOCK_SIZE' are backed by a dataspace
+ *   of their own, which is returned to the RAM session when the block is
+ *   freed.
+ *
+ * Each block is preceded by a header that holds its size. This enables
+ * 'free' to find the responsible tier and 'malloc_usable_size' to report
+ * the size of the block.
  */
 
 /*
@@ -16,14 +34,13 @@
 #include <base/env.h>
 #include <base/printf.h>
 #include <base/slab.h>
+#include <base/heap.h>
 #include <util/string.h>
 #include <util/misc_math.h>
 
 /* libc includes */
 #include <string.h>
 
-typedef unsigned long Block_header;
-
 namespace Genode {
 
 	class Slab_alloc : public Slab
@@ -50,127 +67,128 @@ namespace Genode {
 
 
 /**
- * Allocator that uses slabs for small objects sizes
+ * Backing store of the per-thread caches
+ *
+ * The per-thread caches request blocks of their size classes or blocks
+ * beyond the largest size class. The former are served by one slab
+ * allocator per size class, the latter by the heap or, if large, by a
+ * dataspace of their own. The per-thread caches pass the exact size of
+ * each block to 'free', which is used to find the responsible allocator.
  */
-class Malloc : public Genode::Allocator
+class Malloc_backing_store : public Genode::Allocator
 {
-	private:
+	public:
 
 		enum {
-			SLAB_START = 2,  /* 4 Byte (log2) */
-			SLAB_STOP  = 11, /* 2048 Byte (log2) */
-			NUM_SLABS = (SLAB_STOP - SLAB_START) + 1
+			SLAB_GRANULARITY = 16,
+			MAX_SLAB_SIZE    = 2048,
+			LARGE_BLOCK_SIZE = 64*1024,
 		};
 
-		Genode::Allocator  *_backing_store;        /* back-end allocator */
-		Genode::Slab_alloc *_allocator[NUM_SLABS]; /* slab allocators */
-		Genode::Lock        _lock;
+	private:
+
+		enum { NUM_SLABS = MAX_SLAB_SIZE/SLAB_GRANULARITY + 1 };
+
+		Genode::Allocator   &_heap;
+		Genode::Sliced_heap  _large;
+		Genode::Lock         _lock;
 
-		unsigned long _slab_log2(unsigned long size)
+		/* slab allocators indexed by block size, created on demand */
+		Genode::Slab_alloc  *_slabs[NUM_SLABS];
+
+		Genode::Slab_alloc *_slab(size_t size)
 		{
-			unsigned msb = Genode::log2(size);
-			/* size is greater than msb */
-			if (size > (1U << msb))
-				msb++;
+			if (size > MAX_SLAB_SIZE || size % SLAB_GRANULARITY)
+				return 0;
 
-			/* use smallest slab */
-			if (size < (1U << SLAB_START))
-				msb = SLAB_START;
+			Genode::Slab_alloc *&slab = _slabs[size/SLAB_GRANULARITY];
+			if (!slab)
+				slab = new (&_heap) Genode::Slab_alloc(size, &_heap);
 
-			return msb;
+			return slab;
 		}
 
 	public:
 
-		Malloc(Genode::Allocator *backing_store) : _backing_store(backing_store)
+		Malloc_backing_store(Genode::Allocator &heap)
+		:
+			_heap(heap),
+			_large(Genode::env()->ram_session(), Genode::env()->rm_session())
 		{
-			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++) {
-				_allocator[i - SLAB_START] = new (backing_store)
-				                                 Genode::Slab_alloc(1U << i, backing_store);
-			}
+			for (unsigned i = 0; i < NUM_SLABS; i++)
+				_slabs[i] = 0;
 		}
 
-		/**
-		 * Allocator interface
-		 */
-
 		bool alloc(size_t size, void **out_addr)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
-			/* enforce size to be a multiple of 4 bytes */
-			size = (size + 3) & ~3;
-
-			/*
-			 * We store the size of the allocation at the very
-			 * beginning of the allocated block and return
-			 * the subsequent address. This way, we can retrieve
-			 * the size information when freeing the block.
-			 */
-			unsigned long real_size = size + sizeof(Block_header);
-			unsigned long msb = _slab_log2(real_size);
-			void *addr = 0;
+			if (size >= LARGE_BLOCK_SIZE)
+				return _large.alloc(size, out_addr);
 
-			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP) {
+			Genode::Lock::Guard lock_guard(_lock);
 
-				if (!(_backing_store->alloc(real_size, &addr)))
-					return false;
-			}
-			else
-				if (!(addr = _allocator[msb - SLAB_START]->alloc()))
-					return false;
+			Genode::Slab_alloc *slab = _slab(size);
+			if (slab)
+				return (*out_addr = slab->alloc()) != 0;
 
-			*(Block_header *)addr = real_size;
-			*out_addr = (Block_header *)addr + 1;
-			return true;
+			return _heap.alloc(size, out_addr);
 		}
 
-		void free(void *ptr, size_t /* size */)
+		void free(void *addr, size_t size)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
+			if (size >= LARGE_BLOCK_SIZE) {
+				_large.free(addr, size);
+				return;
+			}
 
-			unsigned long *addr = ((unsigned long *)ptr) - 1;
-			unsigned long  real_size = *addr;
+			Genode::Lock::Guard lock_guard(_lock);
 
-			if (real_size > (1U << SLAB_STOP))
-				_backing_store->free(addr, real_size);
-			else {
-				unsigned long msb = _slab_log2(real_size);
-				_allocator[msb - SLAB_START]->free(addr);
-			}
+			if (_slab(size))
+				Genode::Slab::free(addr);
+			else
+				_heap.free(addr, size);
 		}
 
+		size_t consumed() { return 0; }
+
 		size_t overhead(size_t size)
 		{
-			size += sizeof(Block_header);
+			if (size >= LARGE_BLOCK_SIZE)
+				return _large.overhead(size);
 
-			if (size > (1U << SLAB_STOP))
-				return _backing_store->overhead(size);
+			Genode::Lock::Guard lock_guard(_lock);
 
-			return _allocator[_slab_log2(size) - SLAB_START]->overhead(size);
+			Genode::Slab_alloc *slab = _slab(size);
+			return slab ? slab->overhead(size) : _heap.overhead(size);
 		}
+
+		bool need_size_for_free() const { return true; }
 };
 
 
-static Genode::Allocator *allocator()
+static Genode::Thread_cached_heap *allocator()
 {
-	static Malloc _m(Genode::env()->heap());
-	return &_m;
+	static Malloc_backing_store backing_store(*Genode::env()->heap());
+	static Genode::Thread_cached_heap heap(backing_store);
+	return &heap;
 }
 
 
-extern "C" void *malloc(unsigned size)
+extern "C" void *malloc(size_t size)
 {
 	void *addr;
 	return allocator()->alloc(size, &addr) ? addr : 0;
 }
 
 
-extern "C" void *calloc(unsigned nmemb, unsigned size)
+extern "C" void *calloc(size_t nmemb, size_t size)
 {
+	/* detect overflow of the total size */
+	if (size && nmemb > ~(size_t)0/size)
+		return 0;
+
 	void *addr = malloc(nmemb*size);
-	Genode::memset(addr, 0, nmemb*size);
+	if (addr)
+		Genode::memset(addr, 0, nmemb*size);
 	return addr;
 }
 
@@ -183,7 +201,13 @@ extern "C" void free(void *ptr)
 }
 
 
-extern "C" void *realloc(void *ptr, Genode::size_t size)
+extern "C" size_t malloc_usable_size(void const *ptr)
+{
+	return ptr ? Genode::Thread_cached_heap::usable_size(ptr) : 0;
+}
+
+
+extern "C" void *realloc(void *ptr, size_t size)
 {
 	if (!ptr)
 		return malloc(size);
@@ -193,11 +217,9 @@ extern "C" void *realloc(void *ptr, Genode::size_t size)
 		return 0;
 	}
 
-	/* determine size of old block content (without header) */
-	unsigned long old_size = *((Block_header *)ptr - 1)
-	                         - sizeof(Block_header);
+	size_t const old_size = malloc_usable_size(ptr);
 
-	/* do not reallocate if new size is less than the current size */
+	/* do not reallocate if the block is large enough */
 	if (size <= old_size)
 		return ptr;
 
@@ -206,7 +228,7 @@ extern "C" void *realloc(void *ptr, Genode::size_t size)
 
 	/* copy content from old block into new block */
 	if (new_addr)
-		memcpy(new_addr, ptr, Genode::min(old_size, (unsigned long)size));
+		memcpy(new_addr, ptr, Genode::min(old_size, size));
 
 	/* free old block */
 	free(ptr);
@@ -0,0 +1,193 @@
+/*
+ * \brief  Benchmark of the libc memory allocator
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark measures the throughput of malloc-heavy access patterns
+ * with a growing number of threads, the allocation of large blocks, and
+ * the growth of blocks via 'realloc'. Durations are reported in CPU
+ * cycles.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <trace/timestamp.h>
+
+/* libc includes */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" size_t malloc_usable_size(void const *);
+
+typedef Genode::Trace::Timestamp Timestamp;
+
+
+enum {
+	MAX_THREADS = 16,
+	NUM_SLOTS   = 512,
+	NUM_ROUNDS  = 200000,
+};
+
+
+/**
+ * Pseudo-random number generator, local to each thread
+ */
+static unsigned next_random(unsigned &seed)
+{
+	seed = seed*1103515245 + 12345;
+	return seed >> 8;
+}
+
+
+/**
+ * Size distribution dominated by small blocks, as typical for ported code
+ */
+static size_t random_size(unsigned &seed)
+{
+	unsigned const r = next_random(seed);
+	switch (r % 16) {
+	case 15: return 2048 + r % 16384;
+	case 14:
+	case 13: return 256 + r % 1792;
+	default: return 8 + r % 248;
+	}
+}
+
+
+/**
+ * Allocate and free blocks of random size in random order
+ */
+static void *mixed_worker(void *arg)
+{
+	unsigned seed = (unsigned)(unsigned long)arg;
+	void *slots[NUM_SLOTS];
+	memset(slots, 0, sizeof(slots));
+
+	for (unsigned i = 0; i < NUM_ROUNDS; i++) {
+		void *&slot = slots[next_random(seed) % NUM_SLOTS];
+		if (slot) {
+			free(slot);
+			slot = 0;
+		} else {
+			size_t const size = random_size(seed);
+			slot = malloc(size);
+			if (!slot) {
+				printf("Error: malloc(%zu) failed\n", size);
+				exit(-1);
+			}
+			*(char *)slot = 1;
+		}
+	}
+
+	for (unsigned i = 0; i < NUM_SLOTS; i++)
+		free(slots[i]);
+
+	return 0;
+}
+
+
+static void bench_mixed(unsigned num_threads)
+{
+	pthread_t threads[MAX_THREADS];
+
+	Timestamp const start = Genode::Trace::timestamp();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		pthread_create(&threads[i], 0, mixed_worker, (void *)(unsigned long)(i + 1));
+
+	for (unsigned i = 0; i < num_threads; i++)
+		pthread_join(threads[i], 0);
+
+	Timestamp const duration = Genode::Trace::timestamp() - start;
+
+	printf("mixed sizes, %2u threads: %llu cycles per operation\n",
+	       num_threads, (unsigned long long)(duration/(num_threads*NUM_ROUNDS)));
+}
+
+
+static void bench_large()
+{
+	enum { NUM_BLOCKS = 64, BLOCK_SIZE = 1024*1024, ROUNDS = 16 };
+
+	static void *blocks[NUM_BLOCKS];
+
+	Timestamp const start = Genode::Trace::timestamp();
+
+	for (unsigned r = 0; r < ROUNDS; r++) {
+		for (unsigned i = 0; i < NUM_BLOCKS; i++) {
+			blocks[i] = malloc(BLOCK_SIZE);
+			if (!blocks[i]) {
+				printf("Error: large malloc failed\n");
+				exit(-1);
+			}
+		}
+		for (unsigned i = 0; i < NUM_BLOCKS; i++)
+			free(blocks[i]);
+	}
+
+	Timestamp const duration = Genode::Trace::timestamp() - start;
+
+	printf("large blocks of %u KiB: %llu cycles per malloc/free\n",
+	       BLOCK_SIZE/1024,
+	       (unsigned long long)(duration/(NUM_BLOCKS*ROUNDS)));
+}
+
+
+static void bench_realloc()
+{
+	enum { MAX_SIZE = 4*1024*1024, ROUNDS = 16 };
+
+	unsigned long copies = 0;
+
+	Timestamp const start = Genode::Trace::timestamp();
+
+	for (unsigned r = 0; r < ROUNDS; r++) {
+		char *buf = 0;
+		for (size_t size = 1; size <= MAX_SIZE; size += size/8 + 1) {
+			char *new_buf = (char *)realloc(buf, size);
+			if (!new_buf) {
+				printf("Error: realloc(%zu) failed\n", size);
+				exit(-1);
+			}
+			if (new_buf != buf)
+				copies++;
+
+			buf = new_buf;
+			buf[size - 1] = 1;
+		}
+
+		if (malloc_usable_size(buf) < MAX_SIZE) {
+			printf("Error: usable size of block is too small\n");
+			exit(-1);
+		}
+		free(buf);
+	}
+
+	Timestamp const duration = Genode::Trace::timestamp() - start;
+
+	printf("realloc growth to %u KiB: %llu cycles per round, %lu copies\n",
+	       MAX_SIZE/1024, (unsigned long long)(duration/ROUNDS), copies);
+}
+
+
+int main(int, char **)
+{
+	printf("--- malloc benchmark ---\n");
+
+	for (unsigned n = 1; n <= MAX_THREADS; n *= 2)
+		bench_mixed(n);
+
+	bench_large();
+	bench_realloc();
+
+	printf("--- malloc benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET   = test-malloc_bench
+SRC_CC   = main.cc
+LIBS     = libc libc_log pthread
@@ -83,6 +83,32 @@ namespace Init {
 	}
 
 
+	/**
+	 * Read minimum size of dataspaces to be backed by huge pages
+	 *
+	 * The value is specified via the 'huge_pages_min' attribute of the RAM
+	 * resource node. It is a hint to the RAM session, which is honored on
+	 * platforms that support huge pages.
+	 */
+	inline Genode::size_t read_huge_pages_min(Genode::Xml_node start_node)
+	{
+		Genode::Number_of_bytes huge_pages_min = 0;
+		try {
+			Genode::Xml_node rsc = start_node.sub_node("resource");
+			for (;; rsc = rsc.next("resource")) {
+
+				try {
+					if (rsc.attribute("name").has_value("RAM")) {
+						rsc.attribute("huge_pages_min").value(&huge_pages_min);
+					}
+				} catch (...) { }
+			}
+		} catch (...) { }
+
+		return huge_pages_min;
+	}
+
+
 	/**
 	 * Return true if service XML node matches the specified service name
 	 */
@@ -381,7 +407,7 @@ namespace Init {
 					prio_levels_log2(prio_levels_log2),
 					priority(read_priority(start_node)),
 					ram_quota(read_ram_quota(start_node)),
-					ram(label),
+					ram(label, read_huge_pages_min(start_node)),
 					cpu(label, priority*(Genode::Cpu_session::PRIORITY_LIMIT >> prio_levels_log2))
 				{
 					/* deduce session costs from usable ram quota */
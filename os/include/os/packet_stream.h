@@ -80,6 +80,7 @@
 #include <base/signal.h>
 #include <dataspace/client.h>
 #include <util/string.h>
+#include <trace/events.h>
 
 
 /**
@@ -609,6 +610,8 @@ class Packet_stream_source : private Packet_stream_base
 		 */
 		void submit_packet(Packet_descriptor packet)
 		{
+			Genode::Trace::event(Genode::Trace::PACKET_SUBMIT,
+			                     packet.offset(), packet.size());
 			_submit_transmitter.tx(packet);
 		}
 
@@ -769,6 +772,8 @@ class Packet_stream_sink : private Packet_stream_base
 		 */
 		void acknowledge_packet(Packet_descriptor packet)
 		{
+			Genode::Trace::event(Genode::Trace::PACKET_ACK,
+			                     packet.offset(), packet.size());
 			_ack_transmitter.tx(packet);
 		}
 
@@ -0,0 +1,460 @@
+/*
+ * \brief  Pool of worker threads with work stealing
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__THREAD_POOL_H_
+#define _INCLUDE__OS__THREAD_POOL_H_
+
+#include <base/env.h>
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <base/allocator.h>
+#include <cpu_session/cpu_session.h>
+
+namespace Genode {
+
+	/**
+	 * Pool of worker threads for parallelizing CPU-bound work
+	 *
+	 * Work is expressed as 'Task' objects, which are submitted as part of a
+	 * 'Task_group'. The submitter waits for the completion of all tasks of a
+	 * group via 'join'. While waiting, it executes pending tasks itself.
+	 *
+	 * Each worker has a deque of tasks of its own. Tasks submitted by a
+	 * worker, e.g., when splitting work recursively, are put into its own
+	 * deque and executed in last-in-first-out order. Tasks submitted by other
+	 * threads are distributed among the workers. A worker that runs out of
+	 * work steals the oldest task from the deque of another worker. Idle
+	 * workers block on a semaphore instead of spinning.
+	 *
+	 * The workers are assigned to the CPUs of the CPU session in a
+	 * round-robin fashion.
+	 *
+	 * Task and task-group objects are owned by the submitter and must stay
+	 * valid until 'join' returns.
+	 */
+	class Thread_pool
+	{
+		public:
+
+			enum {
+				MAX_WORKERS = 32,
+				QUEUE_SIZE  = 256,   /* tasks per worker deque */
+				MAX_CHUNKS  = 64,    /* chunks of a 'parallel_for' */
+				STACK_SIZE  = 8*1024*sizeof(long),
+			};
+
+			class Task_group;
+
+			/**
+			 * Unit of work
+			 */
+			class Task
+			{
+				private:
+
+					Task_group *_group;
+
+					friend class Thread_pool;
+
+				public:
+
+					Task() : _group(0) { }
+
+					virtual ~Task() { }
+
+					virtual void execute() = 0;
+			};
+
+			/**
+			 * Set of tasks to wait for
+			 */
+			class Task_group
+			{
+				private:
+
+					Lock      _lock;
+					unsigned  _pending;
+					bool      _waiting;
+					Semaphore _done;
+
+					friend class Thread_pool;
+
+					void _add()
+					{
+						Lock::Guard guard(_lock);
+						_pending++;
+					}
+
+					void _complete()
+					{
+						Lock::Guard guard(_lock);
+
+						if (--_pending == 0 && _waiting) {
+							_waiting = false;
+							_done.up();
+						}
+					}
+
+					/**
+					 * Return true if all tasks are complete, otherwise
+					 * prepare for blocking if requested
+					 */
+					bool _completed(bool block)
+					{
+						Lock::Guard guard(_lock);
+
+						if (!_pending)
+							return true;
+
+						if (block)
+							_waiting = true;
+
+						return false;
+					}
+
+				public:
+
+					Task_group() : _pending(0), _waiting(false) { }
+			};
+
+		private:
+
+			/**
+			 * Deque of tasks
+			 *
+			 * The owning worker takes the newest task, thieves take the
+			 * oldest one.
+			 */
+			class Deque
+			{
+				private:
+
+					Lock     _lock;
+					Task    *_tasks[QUEUE_SIZE];
+					unsigned _head;  /* index of oldest task */
+					unsigned _tail;  /* index behind newest task */
+
+				public:
+
+					Deque() : _head(0), _tail(0) { }
+
+					bool push(Task *task)
+					{
+						Lock::Guard guard(_lock);
+
+						if (_tail - _head == QUEUE_SIZE)
+							return false;
+
+						_tasks[_tail++ % QUEUE_SIZE] = task;
+						return true;
+					}
+
+					Task *pop()
+					{
+						Lock::Guard guard(_lock);
+						return (_tail == _head) ? 0 : _tasks[--_tail % QUEUE_SIZE];
+					}
+
+					Task *steal()
+					{
+						Lock::Guard guard(_lock);
+						return (_tail == _head) ? 0 : _tasks[_head++ % QUEUE_SIZE];
+					}
+			};
+
+			class Worker : public Thread<STACK_SIZE>
+			{
+				private:
+
+					Thread_pool &_pool;
+					unsigned     _index;
+
+				public:
+
+					Deque deque;
+
+					Worker(Thread_pool &pool, unsigned index, char const *name)
+					:
+						Thread<STACK_SIZE>(name), _pool(pool), _index(index)
+					{ }
+
+					void entry() { _pool._work(_index); }
+			};
+
+			friend class Worker;
+
+			Allocator   &_alloc;
+			unsigned     _num_workers;
+			Worker      *_workers[MAX_WORKERS];
+			Semaphore    _work_sem;   /* counts submitted tasks */
+			Lock         _next_lock;
+			unsigned     _next;       /* worker to receive next external task */
+			bool volatile _shutdown;
+
+			/**
+			 * Return index of the calling worker, or '_num_workers' if the
+			 * caller is not a worker of the pool
+			 */
+			unsigned _myself() const
+			{
+				Thread_base * const myself = Thread_base::myself();
+
+				for (unsigned i = 0; i < _num_workers; i++)
+					if (_workers[i] == myself)
+						return i;
+
+				return _num_workers;
+			}
+
+			/**
+			 * Obtain task, preferably from the deque of worker 'index'
+			 */
+			Task *_grab(unsigned index)
+			{
+				if (index < _num_workers)
+					if (Task *task = _workers[index]->deque.pop())
+						return task;
+
+				/* steal from the other workers */
+				for (unsigned i = 1; i <= _num_workers; i++) {
+					unsigned const victim = (index + i) % _num_workers;
+					if (victim == index)
+						continue;
+
+					if (Task *task = _workers[victim]->deque.steal())
+						return task;
+				}
+				return 0;
+			}
+
+			static void _execute(Task *task)
+			{
+				/* the task may be destructed once its group is complete */
+				Task_group * const group = task->_group;
+
+				task->execute();
+				group->_complete();
+			}
+
+			/**
+			 * Main loop of a worker
+			 */
+			void _work(unsigned index)
+			{
+				for (;;) {
+					_work_sem.down();
+
+					if (_shutdown)
+						return;
+
+					/* the task may have been taken by a joining thread */
+					if (Task *task = _grab(index))
+						_execute(task);
+				}
+			}
+
+		public:
+
+			/**
+			 * Constructor
+			 *
+			 * \param alloc        allocator for the worker threads
+			 * \param num_workers  number of worker threads, 0 for one
+			 *                     worker per CPU
+			 * \param cpu          CPU session used for the placement of the
+			 *                     workers
+			 */
+			Thread_pool(Allocator   &alloc,
+			            unsigned     num_workers = 0,
+			            Cpu_session &cpu = *env()->cpu_session())
+			:
+				_alloc(alloc), _num_workers(num_workers), _next(0),
+				_shutdown(false)
+			{
+				unsigned const num_cpus = cpu.num_cpus() ? cpu.num_cpus() : 1;
+
+				if (!_num_workers)
+					_num_workers = num_cpus;
+
+				if (_num_workers > MAX_WORKERS)
+					_num_workers = MAX_WORKERS;
+
+				/* create all workers before starting them to make them see each other */
+				for (unsigned i = 0; i < _num_workers; i++)
+					_workers[i] = new (&_alloc) Worker(*this, i, "pool_worker");
+
+				for (unsigned i = 0; i < _num_workers; i++) {
+					if (num_cpus > 1)
+						cpu.affinity(_workers[i]->cap(), i % num_cpus);
+					_workers[i]->start();
+				}
+			}
+
+			/**
+			 * Destructor
+			 *
+			 * All task groups must be joined before destructing the pool.
+			 */
+			~Thread_pool()
+			{
+				_shutdown = true;
+
+				for (unsigned i = 0; i < _num_workers; i++)
+					_work_sem.up();
+
+				for (unsigned i = 0; i < _num_workers; i++) {
+					_workers[i]->join();
+					destroy(&_alloc, _workers[i]);
+				}
+			}
+
+			/**
+			 * Return number of worker threads
+			 */
+			unsigned num_workers() const { return _num_workers; }
+
+			/**
+			 * Submit task for asynchronous execution
+			 *
+			 * If the deque of the selected worker is full, the task is
+			 * executed right away by the caller.
+			 */
+			void submit(Task &task, Task_group &group)
+			{
+				task._group = &group;
+				group._add();
+
+				unsigned index = _myself();
+				if (index == _num_workers) {
+					Lock::Guard guard(_next_lock);
+					index = _next++ % _num_workers;
+				}
+
+				if (!_workers[index]->deque.push(&task)) {
+					_execute(&task);
+					return;
+				}
+
+				_work_sem.up();
+			}
+
+			/**
+			 * Wait for the completion of all tasks of the group
+			 *
+			 * The caller helps with the execution of pending tasks.
+			 */
+			void join(Task_group &group)
+			{
+				unsigned const index = _myself();
+
+				for (;;) {
+					if (group._completed(false))
+						break;
+
+					if (Task *task = _grab(index)) {
+						_execute(task);
+						continue;
+					}
+
+					/* remaining tasks are in progress, wait for them */
+					if (group._completed(true))
+						break;
+
+					group._done.down();
+				}
+
+				/* synchronize with the completion of the last task */
+				Lock::Guard guard(group._lock);
+			}
+
+			/**
+			 * Execute two tasks in parallel and wait for both
+			 */
+			void fork_join(Task &first, Task &second)
+			{
+				Task_group group;
+				submit(second, group);
+				first.execute();
+				join(group);
+			}
+
+			/**
+			 * Task processing a sub range of a 'parallel_for'
+			 */
+			template <typename FUNC>
+			class Range_task : public Task
+			{
+				private:
+
+					FUNC const   *_func;
+					unsigned long _begin, _end;
+
+				public:
+
+					Range_task() : _func(0), _begin(0), _end(0) { }
+
+					void assign(FUNC const &func, unsigned long begin,
+					            unsigned long end)
+					{
+						_func = &func; _begin = begin; _end = end;
+					}
+
+					void execute() { (*_func)(_begin, _end); }
+			};
+
+			/**
+			 * Process the index range [begin, end) in parallel
+			 *
+			 * \param grain  minimum number of indices per chunk
+			 * \param func   functor called as 'func(chunk_begin, chunk_end)'
+			 *
+			 * The range is split into at most 'MAX_CHUNKS' chunks, four per
+			 * worker at most to compensate an uneven load. The caller
+			 * processes the last chunk itself.
+			 */
+			template <typename FUNC>
+			void parallel_for(unsigned long begin, unsigned long end,
+			                  unsigned long grain, FUNC const &func)
+			{
+				if (end <= begin)
+					return;
+
+				unsigned long const size = end - begin;
+				if (!grain)
+					grain = 1;
+
+				unsigned long num_chunks = (size + grain - 1)/grain;
+				if (num_chunks > 4UL*_num_workers) num_chunks = 4UL*_num_workers;
+				if (num_chunks > MAX_CHUNKS)       num_chunks = MAX_CHUNKS;
+
+				unsigned long const chunk_size = (size + num_chunks - 1)/num_chunks;
+
+				Range_task<FUNC> chunks[MAX_CHUNKS];
+				Task_group       group;
+
+				unsigned long i = 0;
+				for (unsigned long b = begin; b < end; b += chunk_size, i++) {
+					unsigned long const e = (end - b > chunk_size) ? b + chunk_size : end;
+					chunks[i].assign(func, b, e);
+				}
+
+				for (unsigned long c = 0; c + 1 < i; c++)
+					submit(chunks[c], group);
+
+				chunks[i - 1].execute();
+				join(group);
+			}
+	};
+}
+
+#endif /* _INCLUDE__OS__THREAD_POOL_H_ */
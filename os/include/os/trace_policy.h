@@ -0,0 +1,103 @@
+/*
+ * \brief  Tracing policy obtained from the configuration
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__TRACE_POLICY_H_
+#define _INCLUDE__OS__TRACE_POLICY_H_
+
+#include <util/xml_node.h>
+#include <util/string.h>
+#include <base/printf.h>
+#include <trace/events.h>
+
+namespace Genode {
+
+	namespace Trace {
+
+		enum { DEFAULT_BUFFER_SIZE = 64*1024 };
+
+		/**
+		 * Return event group for name as used in the configuration
+		 */
+		inline unsigned event_group(char const *name, size_t len)
+		{
+			static struct { char const *name; unsigned events; } groups[] = {
+				{ "rpc",         RPC         },
+				{ "signal",      SIGNAL      },
+				{ "lock",        LOCK        },
+				{ "page_fault",  PAGE_FAULTS },
+				{ "packet",      PACKET      },
+				{ "all",         ALL         } };
+
+			for (unsigned i = 0; i < sizeof(groups)/sizeof(groups[0]); i++)
+				if (strlen(groups[i].name) == len
+				 && strcmp(groups[i].name, name, len) == 0)
+					return groups[i].events;
+
+			PWRN("unknown trace-event group");
+			return 0;
+		}
+
+		/**
+		 * Apply tracing policy given as '<trace>' sub node of 'config'
+		 *
+		 * Example:
+		 *
+		 * ! <config>
+		 * !   <trace buffer_size="64K" events="rpc lock"/>
+		 * ! </config>
+		 *
+		 * The 'events' attribute lists the groups of trace points to
+		 * enable, separated by spaces. Without a '<trace>' node, tracing
+		 * is disabled. The function can be called again after a
+		 * configuration update to change the set of enabled trace points.
+		 * The trace buffers allocated once are kept.
+		 */
+		inline void apply_policy(Xml_node config)
+		{
+			unsigned events = 0;
+
+			try {
+				Xml_node trace = config.sub_node("trace");
+
+				Number_of_bytes buffer_size = (size_t)DEFAULT_BUFFER_SIZE;
+				try { trace.attribute("buffer_size").value(&buffer_size); }
+				catch (Xml_node::Nonexistent_attribute) { }
+
+				char names[128];
+				names[0] = 0;
+				try { trace.attribute("events").value(names, sizeof(names)); }
+				catch (Xml_node::Nonexistent_attribute) { }
+
+				for (char const *s = names; *s; ) {
+
+					/* skip separating spaces */
+					if (*s == ' ') { s++; continue; }
+
+					size_t len = 0;
+					while (s[len] && s[len] != ' ') len++;
+
+					events |= event_group(s, len);
+					s += len;
+				}
+
+				if (events)
+					Control::arm(buffer_size);
+
+			} catch (Xml_node::Nonexistent_sub_node) { }
+
+			Control::enable(events);
+		}
+	}
+}
+
+#endif /* _INCLUDE__OS__TRACE_POLICY_H_ */
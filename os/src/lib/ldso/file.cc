@@ -85,8 +85,34 @@ namespace Genode {
 			                             size_t size = 0, off_t offset = 0) {
 				return Rm_connection::attach_executable(ds, local_addr - _base, size, offset); }
 
+			/**
+			 * Overwritten from 'Rm_connection'
+			 */
+			Local_addr_batch attach_many(Dataspace_capability ds,
+			                             Attachment_batch const &batch)
+			{
+				Attachment_batch relative = batch;
+				for (unsigned i = 0; i < relative.count; i++)
+					relative.attachment[i].local_addr -= _base;
+
+				Local_addr_batch result = Rm_connection::attach_many(ds, relative);
+				for (unsigned i = 0; i < result.count; i++)
+					result.addr[i] += _base;
+
+				return result;
+			}
+
 			void detach(Local_addr local_addr) {
 				Rm_connection::detach((addr_t)local_addr - _base); }
+
+			void detach_many(Local_addr_batch const &batch)
+			{
+				Local_addr_batch relative = batch;
+				for (unsigned i = 0; i < relative.count; i++)
+					relative.addr[i] -= _base;
+
+				Rm_connection::detach_many(relative);
+			}
 	};
 
 
@@ -113,29 +139,45 @@ namespace Genode {
 			addr_t                   vaddr()      { return _vaddr; }
 			Rom_dataspace_capability dataspace()  { return _ds_rom; }
 
-			void setup_data(addr_t vaddr, addr_t vlimit, addr_t flimit, off_t offset)
+			/**
+			 * Map text segment and copy data segment
+			 *
+			 * The text segment and the file contents of the data segment
+			 * both originate from the ROM dataspace. Hence, they are
+			 * attached with a single 'attach_many' operation.
+			 */
+			void setup_segments(addr_t text_vaddr, size_t text_size,
+			                    off_t text_offset, addr_t data_vaddr,
+			                    addr_t data_vlimit, addr_t data_flimit,
+			                    off_t data_offset)
 			{
+				Rm_area * const area = Rm_area::r();
+
 				/* allocate data segment */
-				_ds_ram = env()->ram_session()->alloc(vlimit - vaddr);
-				Rm_area::r()->attach_at(_ds_ram, vaddr);
+				_ds_ram = env()->ram_session()->alloc(data_vlimit - data_vaddr);
+
+				/* temporary region for the rom data segment */
+				size_t const copy_size  = round_page(data_flimit - data_vaddr);
+				addr_t const copy_vaddr = area->alloc_region(copy_size);
+
+				Rm_session::Attachment_batch batch;
+				batch.add(Rm_session::Attachment(text_size, text_offset, true,
+				                                 text_vaddr, true));
+				batch.add(Rm_session::Attachment(copy_size, data_offset, true,
+				                                 copy_vaddr));
+				area->attach_many(_ds_rom, batch);
+				area->attach_at(_ds_ram, data_vaddr);
 
-				/* map rom data segment */
-				void *rom_data = env()->rm_session()->attach(_ds_rom, 0, offset);
-				
 				/* copy data */
-				memcpy((void *)vaddr, rom_data, flimit - vaddr);
-				env()->rm_session()->detach(rom_data);
+				memcpy((void *)data_vaddr, (void *)copy_vaddr, data_flimit - data_vaddr);
+				area->detach(copy_vaddr);
+				area->free_region(copy_vaddr);
 
 				/* set parent cap (arch.lib.a) */
-				set_parent_cap_arch((void *)vaddr);
+				set_parent_cap_arch((void *)data_vaddr);
 
-				_daddr = vaddr;
-			}
-
-			void setup_text(addr_t vaddr, size_t size, off_t offset)
-			{
-				_vaddr = vaddr;
-				Rm_area::r()->attach_executable(_ds_rom, vaddr, size, offset);
+				_vaddr = text_vaddr;
+				_daddr = data_vaddr;
 			}
 
 			addr_t alloc_region(addr_t vaddr, addr_t vlimit)
@@ -185,8 +227,10 @@ namespace Genode {
 				file_list()->remove(this);
 
 				if (_vaddr != ~0UL) {
-					Rm_area::r()->detach(_vaddr);
-					Rm_area::r()->detach(_daddr);
+					Rm_session::Local_addr_batch segments;
+					segments.add(_vaddr);
+					segments.add(_daddr);
+					Rm_area::r()->detach_many(segments);
 					Rm_area::r()->free_region(_vaddr);
 					env()->ram_session()->free(_ds_ram);
 				}
@@ -356,17 +400,15 @@ extern "C" void *genode_map(int fd, Elf_Phdr **segs)
 		return MAP_FAILED;
 	}
 
-	/* map text segment */
-	h->setup_text(base_vaddr, base_msize, base_offset);
-
 	addr_t offset      = fixed ? 0 : base_vaddr;
 	base_vlimit       += offset;
 	addr_t base_flimit = offset + segs[1]->p_vaddr + segs[1]->p_filesz;
-	base_vaddr         = offset + trunc_page(segs[1]->p_vaddr);
-	base_offset        = trunc_page(segs[1]->p_offset);
-	
-	/* copy data segment */
-	h->setup_data(base_vaddr, base_vlimit, base_flimit, base_offset);
+	addr_t data_vaddr  = offset + trunc_page(segs[1]->p_vaddr);
+	addr_t data_offset = trunc_page(segs[1]->p_offset);
+
+	/* map text segment and copy data segment */
+	h->setup_segments(base_vaddr, base_msize, base_offset,
+	                  data_vaddr, base_vlimit, base_flimit, data_offset);
 
 	return (void *)h->vaddr();
 }
@@ -61,6 +61,26 @@ namespace Genode {
 				Ram_session_client::free(ds);
 			}
 
+			Ram_dataspace_capability clone(Ram_dataspace_capability ds)
+			{
+				Lock::Guard _consumed_lock_guard(_consumed_lock);
+
+				size_t const size = Dataspace_client(ds).size();
+
+				if ((_amount - _consumed) < size) {
+					PWRN("Quota exceeded! amount=%zu, size=%zu, consumed=%zu",
+					     _amount, size, _consumed);
+					return Ram_dataspace_capability();
+				}
+
+				Ram_dataspace_capability cap = Ram_session_client::clone(ds);
+
+				if (cap.valid())
+					_consumed += size;
+
+				return cap;
+			}
+
 			int transfer_quota(Ram_session_capability ram_session, size_t amount)
 			{
 				Lock::Guard _consumed_lock_guard(_consumed_lock);
@@ -7,6 +7,9 @@
 #ifndef _NODE_HANDLE_REGISTRY_H_
 #define _NODE_HANDLE_REGISTRY_H_
 
+/* Genode includes */
+#include <base/rw_lock.h>
+
 namespace File_system {
 
 	class Node;
@@ -41,7 +44,8 @@ namespace File_system {
 			/* maximum number of open nodes per session */
 			enum { MAX_NODE_HANDLES = 128U };
 
-			Lock mutable _lock;
+			/* lookups are far more frequent than allocations */
+			Rw_lock mutable _lock;
 
 			Node *_nodes[MAX_NODE_HANDLES];
 
@@ -58,7 +62,7 @@ namespace File_system {
 			 */
 			int _alloc(Node *node)
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Write_guard guard(_lock);
 
 				for (unsigned i = 0; i < MAX_NODE_HANDLES; i++)
 					if (!_nodes[i]) {
@@ -94,7 +98,7 @@ namespace File_system {
 			 */
 			void free(Node_handle handle)
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Write_guard guard(_lock);
 
 				if (!_in_range(handle.value))
 					return;
@@ -132,7 +136,7 @@ namespace File_system {
 			template <typename HANDLE_TYPE>
 			typename Node_type<HANDLE_TYPE>::Type *lookup_and_lock(HANDLE_TYPE handle)
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Read_guard guard(_lock);
 
 				if (!_in_range(handle.value))
 					throw Invalid_handle();
@@ -148,7 +152,7 @@ namespace File_system {
 
 			bool refer_to_same_node(Node_handle h1, Node_handle h2) const
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Read_guard guard(_lock);
 
 				if (!_in_range(h1.value) || !_in_range(h2.value)) {
 					PDBG("refer_to_same_node -> Invalid_handle");
@@ -163,7 +167,7 @@ namespace File_system {
 			 */
 			void sigh(Node_handle handle, Signal_context_capability sigh)
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Write_guard guard(_lock);
 
 				if (!_in_range(handle.value))
 					throw Invalid_handle();
@@ -27,12 +27,16 @@ volatile int dummy;
 
 static void prefetch_dataspace(Genode::Dataspace_capability ds)
 {
-	char *mapped = Genode::env()->rm_session()->attach(ds);
+	char *mapped = Genode::env()->rm_session()->attach_populated(ds);
 	Genode::size_t size = Genode::Dataspace_client(ds).size();
 
 	/*
 	 * Modify global volatile 'dummy' variable to prevent the compiler
 	 * from removing the prefetch loop.
+	 *
+	 * The loop is needed even though the dataspace is attached populated
+	 * because the 'populate' hint is not supported on all kernels and
+	 * managed dataspaces are populated lazily by their provider.
 	 */
 
 	enum { PREFETCH_STEP = 4096 };
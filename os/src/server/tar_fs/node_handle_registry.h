@@ -14,6 +14,9 @@
 #ifndef _NODE_HANDLE_REGISTRY_H_
 #define _NODE_HANDLE_REGISTRY_H_
 
+/* Genode includes */
+#include <base/rw_lock.h>
+
 namespace File_system {
 
 	class Node;
@@ -48,7 +51,8 @@ namespace File_system {
 			/* maximum number of open nodes per session */
 			enum { MAX_NODE_HANDLES = 128U };
 
-			Lock mutable _lock;
+			/* lookups are far more frequent than allocations */
+			Rw_lock mutable _lock;
 
 			Node *_nodes[MAX_NODE_HANDLES];
 
@@ -59,7 +63,7 @@ namespace File_system {
 			 */
 			int _alloc(Node *node)
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Write_guard guard(_lock);
 
 				for (unsigned i = 0; i < MAX_NODE_HANDLES; i++)
 					if (!_nodes[i]) {
@@ -95,7 +99,7 @@ namespace File_system {
 			 */
 			void free(Node_handle handle)
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Write_guard guard(_lock);
 
 				if (_in_range(handle.value))
 					_nodes[handle.value] = 0;
@@ -109,7 +113,7 @@ namespace File_system {
 			template <typename HANDLE_TYPE>
 			typename Node_type<HANDLE_TYPE>::Type *lookup(HANDLE_TYPE handle)
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Read_guard guard(_lock);
 
 				if (!_in_range(handle.value))
 					throw Invalid_handle();
@@ -124,7 +128,7 @@ namespace File_system {
 
 			bool refer_to_same_node(Node_handle h1, Node_handle h2) const
 			{
-				Lock::Guard guard(_lock);
+				Rw_lock::Read_guard guard(_lock);
 
 				if (!_in_range(h1.value) || !_in_range(h2.value))
 					throw Invalid_handle();
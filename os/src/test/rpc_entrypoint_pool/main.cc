@@ -0,0 +1,164 @@
+/*
+ * \brief  Throughput of a multi-threaded RPC entrypoint
+ * \author agent
+ * \date   2026-10-17
+ *
+ * A number of client threads issue RPC calls to an 'Rpc_entrypoint_pool'
+ * within the same component. Each client uses its own server object, which
+ * performs a fixed amount of work per call. The test reports the number of
+ * calls per million CPU cycles for an increasing number of clients, first
+ * for a single-threaded entrypoint as baseline, then for an entrypoint with
+ * the number of threads taken from the config.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/thread.h>
+#include <base/rpc_entrypoint_pool.h>
+#include <base/rpc_client.h>
+#include <cap_session/connection.h>
+#include <os/config.h>
+#include <trace/timestamp.h>
+
+
+/*******************
+ ** RPC interface **
+ *******************/
+
+namespace Test {
+
+	struct Work
+	{
+		virtual unsigned long work(unsigned long iterations) = 0;
+
+		GENODE_RPC(Rpc_work, unsigned long, work, unsigned long);
+		GENODE_RPC_INTERFACE(Rpc_work);
+	};
+
+
+	struct Work_component : Genode::Rpc_object<Work, Work_component>
+	{
+		unsigned long work(unsigned long iterations)
+		{
+			unsigned long volatile sum = 0;
+			for (unsigned long i = 0; i < iterations; i++)
+				sum += i;
+
+			return sum;
+		}
+	};
+
+
+	struct Work_client : Genode::Rpc_client<Work>
+	{
+		Work_client(Genode::Capability<Work> cap)
+		: Genode::Rpc_client<Work>(cap) { }
+
+		unsigned long work(unsigned long iterations) {
+			return call<Rpc_work>(iterations); }
+	};
+}
+
+
+/************
+ ** Client **
+ ************/
+
+using namespace Genode;
+
+enum { CALLS_PER_CLIENT = 20000, ITERATIONS_PER_CALL = 2000 };
+
+
+class Client : public Thread<4096*sizeof(long)>
+{
+	private:
+
+		Test::Work_client _work;
+
+	public:
+
+		Client(Capability<Test::Work> cap) : Thread("client"), _work(cap) { }
+
+		void entry()
+		{
+			for (unsigned i = 0; i < CALLS_PER_CLIENT; i++)
+				_work.work(ITERATIONS_PER_CALL);
+		}
+};
+
+
+/**
+ * Run benchmark with 'num_clients' clients
+ */
+static void measure(Rpc_entrypoint_pool &ep, unsigned num_clients)
+{
+	enum { MAX_CLIENTS = 16 };
+
+	static Test::Work_component components[MAX_CLIENTS];
+	Client *clients[MAX_CLIENTS];
+
+	for (unsigned i = 0; i < num_clients; i++)
+		clients[i] = new (env()->heap()) Client(ep.manage(&components[i]));
+
+	Trace::Timestamp const start = Trace::timestamp();
+
+	for (unsigned i = 0; i < num_clients; i++)
+		clients[i]->start();
+
+	for (unsigned i = 0; i < num_clients; i++)
+		clients[i]->join();
+
+	Trace::Timestamp const cycles = Trace::timestamp() - start;
+
+	unsigned long const calls  = (unsigned long)num_clients*CALLS_PER_CLIENT;
+	unsigned long const mcycles = (unsigned long)(cycles / 1000000);
+
+	printf("%2u clients, %u threads: %lu calls, %lu calls per Mcycle\n",
+	       num_clients, ep.num_threads(), calls,
+	       mcycles ? calls / mcycles : 0);
+
+	for (unsigned i = 0; i < num_clients; i++) {
+		destroy(env()->heap(), clients[i]);
+		ep.dissolve(&components[i]);
+	}
+}
+
+
+int main(int, char **)
+{
+	printf("--- RPC entrypoint pool test started ---\n");
+
+	unsigned num_threads = 1, max_clients = 8;
+	try {
+		Xml_node ep_node = config()->xml_node().sub_node("entrypoint");
+		ep_node.attribute("threads").value(&num_threads);
+	} catch (...) { }
+	try {
+		config()->xml_node().attribute("max_clients").value(&max_clients);
+	} catch (...) { }
+
+	enum { STACK_SIZE = 4096*sizeof(long) };
+	static Cap_connection cap;
+
+	unsigned const thread_counts[] = { 1, num_threads };
+	for (unsigned i = 0; i < sizeof(thread_counts)/sizeof(thread_counts[0]); i++) {
+
+		Rpc_entrypoint_pool ep(&cap, STACK_SIZE, "work_ep",
+		                       thread_counts[i], env()->heap());
+
+		for (unsigned num_clients = 1; num_clients <= max_clients && num_clients <= 16;
+		     num_clients *= 2)
+			measure(ep, num_clients);
+	}
+
+	printf("--- RPC entrypoint pool test finished ---\n");
+	return 0;
+}
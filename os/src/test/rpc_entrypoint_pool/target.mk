@@ -0,0 +1,3 @@
+TARGET = test-rpc_entrypoint_pool
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,183 @@
+/*
+ * \brief  Scaling benchmark of the thread pool
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark runs two workloads with 1, 2, 4, and 8 workers and reports
+ * the duration in CPU cycles and the speedup relative to one worker:
+ *
+ * - A checksum pass over a buffer, parallelized via 'parallel_for'
+ * - A recursive computation split via 'fork_join', which relies on work
+ *   stealing to distribute the tasks
+ *
+ * The results are compared with a sequential computation.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <os/thread_pool.h>
+#include <os/attached_ram_dataspace.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+typedef Trace::Timestamp Timestamp;
+
+
+enum {
+	BUF_SIZE   = 8*1024*1024,
+	BLOCK_SIZE = 16*1024,
+	NUM_BLOCKS = BUF_SIZE/BLOCK_SIZE,
+	FIB_N      = 27,
+	FIB_CUTOFF = 16,  /* compute sequentially below this value */
+};
+
+
+/***********************
+ ** Checksum workload **
+ ***********************/
+
+static unsigned long checksum(unsigned char const *data, size_t len)
+{
+	/* Fletcher-like checksum, cheap but not trivially vectorizable */
+	unsigned long a = 1, b = 0;
+	for (size_t i = 0; i < len; i++) {
+		a = (a + data[i]) % 65521;
+		b = (b + a)       % 65521;
+	}
+	return (b << 16) | a;
+}
+
+
+struct Checksum_blocks
+{
+	unsigned char const *buf;
+	unsigned long       *result;
+
+	void operator () (unsigned long begin, unsigned long end) const
+	{
+		for (unsigned long i = begin; i < end; i++)
+			result[i] = checksum(buf + i*BLOCK_SIZE, BLOCK_SIZE);
+	}
+};
+
+
+static unsigned long combine(unsigned long const *result)
+{
+	unsigned long sum = 0;
+	for (unsigned i = 0; i < NUM_BLOCKS; i++)
+		sum = sum*31 + result[i];
+	return sum;
+}
+
+
+/************************
+ ** Fork/join workload **
+ ************************/
+
+static unsigned long fib_seq(unsigned n) {
+	return n < 2 ? n : fib_seq(n - 1) + fib_seq(n - 2); }
+
+
+struct Fib_task : Thread_pool::Task
+{
+	Thread_pool  &pool;
+	unsigned      n;
+	unsigned long result;
+
+	Fib_task(Thread_pool &pool, unsigned n) : pool(pool), n(n), result(0) { }
+
+	void execute()
+	{
+		if (n < FIB_CUTOFF) {
+			result = fib_seq(n);
+			return;
+		}
+
+		Fib_task a(pool, n - 1), b(pool, n - 2);
+		pool.fork_join(a, b);
+		result = a.result + b.result;
+	}
+};
+
+
+/***************
+ ** Benchmark **
+ ***************/
+
+int main(int argc, char **argv)
+{
+	printf("--- thread pool benchmark started ---\n");
+
+	static Attached_ram_dataspace buf_ds(env()->ram_session(), BUF_SIZE);
+	static unsigned long result[NUM_BLOCKS];
+
+	unsigned char *buf = buf_ds.local_addr<unsigned char>();
+	for (unsigned i = 0; i < BUF_SIZE; i++)
+		buf[i] = (unsigned char)(i*7 + (i >> 11));
+
+	/* sequential reference */
+	Checksum_blocks const blocks = { buf, result };
+	blocks(0, NUM_BLOCKS);
+	unsigned long const expected_sum = combine(result);
+	unsigned long const expected_fib = fib_seq(FIB_N);
+
+	printf("CPUs: %u\n", env()->cpu_session()->num_cpus());
+
+	Timestamp base_sum = 0, base_fib = 0;
+
+	static unsigned const num_workers[] = { 1, 2, 4, 8 };
+
+	for (unsigned i = 0; i < sizeof(num_workers)/sizeof(num_workers[0]); i++) {
+
+		Thread_pool pool(*env()->heap(), num_workers[i]);
+
+		/* checksum */
+		for (unsigned j = 0; j < NUM_BLOCKS; j++)
+			result[j] = 0;
+
+		Timestamp t0 = Trace::timestamp();
+		pool.parallel_for(0, NUM_BLOCKS, 1, blocks);
+		Timestamp const sum_time = Trace::timestamp() - t0;
+
+		if (combine(result) != expected_sum) {
+			PERR("checksum mismatch with %u workers", num_workers[i]);
+			return -1;
+		}
+
+		/* fork/join */
+		Fib_task fib(pool, FIB_N);
+		t0 = Trace::timestamp();
+		fib.execute();
+		Timestamp const fib_time = Trace::timestamp() - t0;
+
+		if (fib.result != expected_fib) {
+			PERR("fork/join result mismatch with %u workers", num_workers[i]);
+			return -1;
+		}
+
+		if (!base_sum) base_sum = sum_time;
+		if (!base_fib) base_fib = fib_time;
+
+		printf("workers=%u checksum=%llu cycles (speedup %llu.%02llu) "
+		       "fork_join=%llu cycles (speedup %llu.%02llu)\n",
+		       num_workers[i],
+		       (unsigned long long)sum_time,
+		       (unsigned long long)(base_sum/sum_time),
+		       (unsigned long long)((base_sum*100/sum_time) % 100),
+		       (unsigned long long)fib_time,
+		       (unsigned long long)(base_fib/fib_time),
+		       (unsigned long long)((base_fib*100/fib_time) % 100));
+	}
+
+	printf("--- thread pool benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,257 @@
+/*
+ * \brief  Test for the tracing of events
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The test arms tracing according to its configuration, triggers the
+ * built-in trace points for RPCs, signals, and lock contention, and checks
+ * the recorded events. It accesses the trace buffer of the main thread via
+ * a second mapping of its dataspace, like a monitor would do, and measures
+ * the costs of disabled and enabled trace points. Finally, the trace
+ * buffers are dumped for the post processing by 'tool/trace_dump'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <base/signal.h>
+#include <os/config.h>
+#include <os/trace_policy.h>
+#include <trace/logger.h>
+
+using namespace Genode;
+
+typedef Trace::Timestamp Timestamp;
+
+
+/**
+ * Obtain the buffer of the thread with the given name
+ */
+struct Buffer_lookup : Trace::Buffer_handler
+{
+	char const               *name;
+	Ram_dataspace_capability  ds;
+	Trace::Buffer const      *buffer;
+
+	Buffer_lookup(char const *name) : name(name), buffer(0)
+	{
+		Trace::Control::for_each_buffer(*this);
+	}
+
+	void handle_buffer(Ram_dataspace_capability buffer_ds,
+	                   Trace::Buffer const &b)
+	{
+		if (strcmp(b.name(), name) == 0) {
+			ds     = buffer_ds;
+			buffer = &b;
+		}
+	}
+};
+
+
+/**
+ * Count events of the given type recorded since sequence number 'from'
+ */
+static unsigned long count(Trace::Buffer const &buffer, unsigned long from,
+                           Trace::Event_type type)
+{
+	unsigned long n = 0;
+	for (unsigned long seq = from; seq < buffer.head(); seq++) {
+		Trace::Event e;
+		if (buffer.read(seq, &e) && e.type == (unsigned long)type)
+			n++;
+	}
+	return n;
+}
+
+
+static bool check(char const *what, unsigned long value, unsigned long expected)
+{
+	printf("%s: %lu\n", what, value);
+	if (value == expected)
+		return true;
+
+	PERR("%s is %lu, expected %lu", what, value, expected);
+	return false;
+}
+
+
+/**
+ * Thread that holds a lock for a while
+ */
+class Holder : public Thread<4096*sizeof(long)>
+{
+	private:
+
+		Lock      &_lock;
+		Semaphore  _locked;
+
+	public:
+
+		Holder(Lock &lock) : Thread<4096*sizeof(long)>("holder"), _lock(lock) { }
+
+		void entry()
+		{
+			Lock::Guard guard(_lock);
+			_locked.up();
+
+			/* keep the lock long enough to let the main thread block */
+			Timestamp const t0 = Trace::timestamp();
+			while (Trace::timestamp() - t0 < 100*1000*1000) ;
+		}
+
+		void wait_until_locked() { _locked.down(); }
+};
+
+
+static bool test_rpc(Trace::Buffer const &buffer)
+{
+	enum { ROUNDS = 10 };
+
+	unsigned long const from = buffer.head();
+	for (unsigned i = 0; i < ROUNDS; i++)
+		env()->ram_session()->quota();
+
+	return check("RPC calls",    count(buffer, from, Trace::RPC_CALL),     ROUNDS)
+	    && check("RPC replies",  count(buffer, from, Trace::RPC_RETURNED), ROUNDS);
+}
+
+
+static bool test_signal(Trace::Buffer const &buffer, unsigned long expected)
+{
+	Signal_receiver  receiver;
+	Signal_context   context;
+	Signal_transmitter transmitter(receiver.manage(&context));
+
+	unsigned long const from = buffer.head();
+	transmitter.submit();
+	receiver.wait_for_signal();
+
+	bool const ok = check("signal submits",  count(buffer, from, Trace::SIGNAL_SUBMIT),   expected)
+	             && check("signal receipts", count(buffer, from, Trace::SIGNAL_RECEIVED), expected);
+
+	receiver.dissolve(&context);
+	return ok;
+}
+
+
+static bool test_lock(Trace::Buffer const &buffer)
+{
+	static Lock lock;
+
+	Holder holder(lock);
+	holder.start();
+	holder.wait_until_locked();
+
+	unsigned long const from = buffer.head();
+	lock.lock();
+	lock.unlock();
+
+	holder.join();
+
+	/* the holder got its buffer at construction time */
+	Buffer_lookup holder_buffer("holder");
+
+	return check("lock contentions", count(buffer, from, Trace::LOCK_CONTENDED), 1)
+	    && check("holder buffer",    holder_buffer.buffer != 0, 1);
+}
+
+
+/**
+ * Read the buffer via a second mapping of its dataspace
+ */
+static bool test_monitor(Buffer_lookup const &main_buffer)
+{
+	Trace::Buffer const *monitored =
+		env()->rm_session()->attach(main_buffer.ds);
+
+	unsigned long const head = main_buffer.buffer->head();
+	bool const ok = check("monitored events", monitored->head() >= head, 1);
+
+	env()->rm_session()->detach(monitored);
+	return ok;
+}
+
+
+static bool test_overwrite(Trace::Buffer const &buffer)
+{
+	/* record more events than the buffer can hold */
+	unsigned long const from = buffer.head();
+	Trace::Event e;
+	for (unsigned i = 0; buffer.tail() <= from; i++)
+		Trace::event(Trace::PACKET_SUBMIT, i, 0);
+
+	return check("overwritten event readable", buffer.read(from, &e), 0)
+	    && check("newest event readable", buffer.read(buffer.head() - 1, &e), 1);
+}
+
+
+static void measure_costs()
+{
+	enum { ROUNDS = 100000 };
+
+	unsigned const events = Trace::Control::enabled_events();
+
+	for (unsigned enabled = 0; enabled < 2; enabled++) {
+
+		Trace::Control::enable(enabled ? (events | Trace::PACKET) : events);
+
+		Timestamp const t0 = Trace::timestamp();
+		for (unsigned i = 0; i < ROUNDS; i++)
+			Trace::event(Trace::PACKET_SUBMIT, i, 0);
+		Timestamp const duration = Trace::timestamp() - t0;
+
+		printf("%s trace point: %llu cycles\n", enabled ? "enabled" : "disabled",
+		       (unsigned long long)(duration/ROUNDS));
+	}
+
+	Trace::Control::enable(events);
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- trace test started ---\n");
+
+	Trace::apply_policy(config()->xml_node());
+
+	if (!check("events enabled", Trace::Control::enabled_events(),
+	           Trace::RPC | Trace::LOCK))
+		return -1;
+
+	Buffer_lookup main_buffer("main");
+	if (!main_buffer.buffer) {
+		PERR("main thread has no trace buffer");
+		return -1;
+	}
+	Trace::Buffer const &buffer = *main_buffer.buffer;
+
+	/* signal trace points are disabled by the configuration */
+	if (!test_rpc(buffer) || !test_signal(buffer, 0) || !test_lock(buffer))
+		return -1;
+
+	Trace::Control::enable(Trace::Control::enabled_events() | Trace::SIGNAL);
+	if (!test_signal(buffer, 1) || !test_monitor(main_buffer))
+		return -1;
+
+	measure_costs();
+
+	Trace::Control::enable(Trace::Control::enabled_events() | Trace::PACKET);
+	if (!test_overwrite(buffer))
+		return -1;
+
+	Trace::Control::enable(Trace::RPC | Trace::SIGNAL | Trace::LOCK);
+	Trace::Control::dump();
+
+	printf("--- trace test finished ---\n");
+	return 0;
+}
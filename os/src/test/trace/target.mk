@@ -0,0 +1,3 @@
+TARGET = test-trace
+SRC_CC = main.cc
+LIBS   = base
@@ -41,6 +41,12 @@ void Ram_session_component::free(Ram_dataspace_capability ds_cap)
 }
 
 
+Ram_dataspace_capability Ram_session_component::clone(Ram_dataspace_capability ds_cap)
+{
+	return _parent_ram_session.clone(ds_cap);
+}
+
+
 int Ram_session_component::ref_account(Ram_session_capability ram_session_cap)
 {
 	return _parent_ram_session.ref_account(ram_session_cap);
@@ -58,7 +58,8 @@ Rm_session::Local_addr
 Rm_session_component::attach(Dataspace_capability ds_cap, size_t size,
                              off_t offset, bool use_local_addr,
                              Rm_session::Local_addr local_addr,
-                             bool executable)
+                             bool executable,
+                             bool populate)
 {
 	if (verbose)
 		PDBG("size = %zd, offset = %x", size, (unsigned int)offset);
@@ -79,7 +80,7 @@ Rm_session_component::attach(Dataspace_capability ds_cap, size_t size,
 
 	void *addr = _parent_rm_session.attach(ds_cap, size, offset,
 	                                       use_local_addr, local_addr,
-	                                       executable);
+	                                       executable, populate);
 
 	Lock::Guard lock_guard(_region_map_lock);
 	_region_map.insert(new (env()->heap()) Region(addr, (void*)((addr_t)addr + size - 1), ds_cap, offset));
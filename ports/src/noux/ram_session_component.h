@@ -43,6 +43,20 @@ namespace Noux {
 		                          Dataspace_registry    &,
 		                          Rpc_entrypoint        &)
 		{
+			/*
+			 * Let the RAM session copy the dataspace, which copies only the
+			 * memory actually used where supported
+			 */
+			try {
+				Ram_dataspace_capability const clone =
+					Ram_session_client(ram).clone(static_cap_cast<Ram_dataspace>(ds_cap()));
+
+				if (clone.valid())
+					return clone;
+			} catch (...) {
+				return Dataspace_capability();
+			}
+
 			size_t const size = Dataspace_client(ds_cap()).size();
 
 			Ram_dataspace_capability dst_ds;
@@ -151,6 +165,25 @@ namespace Noux {
 				return ds_cap;
 			}
 
+			Ram_dataspace_capability clone(Ram_dataspace_capability src_cap)
+			{
+				Ram_dataspace_capability ds_cap =
+					env()->ram_session()->clone(src_cap);
+
+				if (!ds_cap.valid())
+					return ds_cap;
+
+				Ram_dataspace_info *ds_info = new (env()->heap())
+				                              Ram_dataspace_info(ds_cap);
+
+				_used_quota += ds_info->size();
+
+				_registry.insert(ds_info);
+				_list.insert(ds_info);
+
+				return ds_cap;
+			}
+
 			void free(Ram_dataspace_capability ds_cap)
 			{
 				Ram_dataspace_info *ds_info =
@@ -187,7 +187,8 @@ namespace Noux {
 			                  size_t size = 0, off_t offset = 0,
 			                  bool use_local_addr = false,
 			                  Local_addr local_addr = (addr_t)0,
-			                  bool executable = false)
+			                  bool executable = false,
+			                  bool populate = false)
 			{
 				if (size == 0)
 					size = Dataspace_client(ds).size();
@@ -199,7 +200,7 @@ namespace Noux {
 
 				local_addr = _rm.attach(ds, size, offset,
 				                        use_local_addr, local_addr,
-				                        executable);
+				                        executable, populate);
 
 				/*
 				 * Record attachement for later replay (needed during